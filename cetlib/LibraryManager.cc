@@ -3,6 +3,7 @@
 #include "boost/filesystem.hpp"
 #include "boost/regex.hpp"
 #include "cetlib/container_algorithms.h"
+#include "cetlib/detail/for_each_range.h"
 #include "cetlib/detail/plugin_search_path.h"
 #include "cetlib/plugin_libpath.h"
 #include "cetlib/search_path.h"
@@ -15,8 +16,11 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iterator>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -44,40 +48,67 @@ cet::LibraryManager::LibraryManager(search_path search_path,
   : search_path_{detail::plugin_search_path(std::move(search_path))}
   , lib_type_{std::move(lib_type)}
   , pattern_stem_{std::move(pattern)}
+{}
+
+cet::LibraryManager::LibraryManager(std::string lib_type)
+  : LibraryManager{std::move(lib_type), default_pattern_stem}
+{}
+
+cet::LibraryManager::LibraryManager(std::string lib_type, std::string pattern)
+  : LibraryManager{search_path{plugin_libpath(), std::nothrow},
+                   std::move(lib_type),
+                   std::move(pattern)}
+{}
+
+cet::LibraryManager::~LibraryManager() = default;
+
+void
+cet::LibraryManager::scan() const
 {
   std::vector<std::string> matches;
-  search_path_.find_files(
-    shlib_prefix() + pattern_stem_ + lib_type_ + dllExtPattern(), matches);
+  {
+    PluginLoadTimes::sentry const timing{&load_times_,
+                                         PluginLoadTimes::Stage::DirectoryScan,
+                                         search_path_.to_string()};
+    search_path_.find_files(
+      shlib_prefix() + pattern_stem_ + lib_type_ + dllExtPattern(), matches);
+  }
+
+  // The tables are built as locals, and swapped in only once complete,
+  // so that a scan that throws leaves them empty, to be retried.
+  lib_loc_map_t lib_loc_map;
+  spec_trans_map_t spec_trans_map;
+  good_spec_trans_map_t good_spec_trans_map;
+  lib_ptr_map_t lib_ptr_map;
 
   // Note the use of reverse iterators here: files found earlier in
   // the vector will therefore overwrite those found later, which is
   // what we want from "search path"-type behavior.
-  std::for_each(matches.rbegin(), matches.rend(), [this](auto const& match) {
-    this->lib_loc_map_inserter(match);
-  });
+  std::for_each(
+    matches.rbegin(), matches.rend(), [&lib_loc_map](auto const& match) {
+      lib_loc_map_inserter(lib_loc_map, match);
+    });
 
   // Build the spec to long library name translation table.
-  for (auto const& p : lib_loc_map_) {
-    spec_trans_map_inserter(p);
+  for (auto const& p : lib_loc_map) {
+    spec_trans_map_inserter(spec_trans_map, p);
   }
 
   // Build the fast good-translation table.
-  for (auto const& p : spec_trans_map_) {
-    good_spec_trans_map_inserter(p);
+  for (auto const& p : spec_trans_map) {
+    good_spec_trans_map_inserter(good_spec_trans_map, p);
   }
-}
 
-cet::LibraryManager::LibraryManager(std::string lib_type)
-  : LibraryManager{std::move(lib_type), default_pattern_stem}
-{}
-
-cet::LibraryManager::LibraryManager(std::string lib_type, std::string pattern)
-  : LibraryManager{search_path{plugin_libpath(), std::nothrow},
-                   std::move(lib_type),
-                   std::move(pattern)}
-{}
+  // Create a (not-yet-loaded) handle for each loadable library.
+  for (auto const& p : lib_loc_map) {
+    lib_ptr_map.try_emplace(p.second);
+  }
 
-cet::LibraryManager::~LibraryManager() = default;
+  lib_loc_map_.swap(lib_loc_map);
+  spec_trans_map_.swap(spec_trans_map);
+  good_spec_trans_map_.swap(good_spec_trans_map);
+  lib_ptr_map_.swap(lib_ptr_map);
+}
 
 size_t
 cet::LibraryManager::getLoadableLibraries(std::vector<std::string>& list) const
@@ -100,6 +131,7 @@ cet::LibraryManager::getValidLibspecs(std::vector<std::string>& list) const
 std::pair<std::string, std::string>
 cet::LibraryManager::getSpecsByPath(std::string const& lib_loc) const
 {
+  ensure_scanned();
   // pair<short_spec,full_spec>
   std::pair<std::string, std::string> result;
   for (auto const& entry : spec_trans_map_) {
@@ -123,6 +155,7 @@ cet::LibraryManager::getSpecsByPath(std::string const& lib_loc) const
 void
 cet::LibraryManager::loadAllLibraries() const
 {
+  ensure_scanned();
   for (auto const& lib : lib_loc_map_) {
     if (get_lib_ptr(lib.second) == nullptr) {
       throw exception("Configuration")
@@ -132,40 +165,71 @@ cet::LibraryManager::loadAllLibraries() const
   }
 }
 
+std::vector<cet::LibraryManager::preload_result>
+cet::LibraryManager::preload(std::vector<std::string> const& libspecs,
+                             unsigned nthreads) const
+{
+  std::vector<preload_result> results;
+  results.reserve(libspecs.size());
+  for (auto const& libspec : libspecs) {
+    results.push_back({libspec});
+  }
+
+  if (nthreads == 0u) {
+    nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  nthreads = std::min<std::size_t>(nthreads, results.size());
+
+  // Each thread claims the next unprocessed entry until none remain.
+  // Concurrent requests for the same library are resolved by
+  // get_lib_ptr, which dlopens each library only once.
+  std::atomic<std::size_t> next{};
+  detail::for_each_thread(nthreads, [this, &results, &next](unsigned) {
+    for (auto i = next++; i < results.size(); i = next++) {
+      preload_one(results[i]);
+    }
+  });
+  return results;
+}
+
 bool
 cet::LibraryManager::libraryIsLoaded(std::string const& path) const
 {
-  return lib_ptr_map_.find(path) != lib_ptr_map_.end();
+  ensure_scanned();
+  if (auto const it = lib_ptr_map_.find(path); it != lib_ptr_map_.cend()) {
+    return it->second.ptr.load(std::memory_order_acquire) != nullptr;
+  }
+  std::lock_guard sentry{extra_lib_ptr_mutex_};
+  auto const it = extra_lib_ptr_map_.find(path);
+  return it != extra_lib_ptr_map_.cend() &&
+         it->second.ptr.load(std::memory_order_acquire) != nullptr;
 }
 
 bool
 cet::LibraryManager::libraryIsLoadable(std::string const& path) const
 {
-  // TODO: If called with any frequency, this should be made more
-  // efficient.
-  for (auto const& lib : lib_loc_map_) {
-    if (path == lib.second) {
-      return true;
-    }
-  }
-  return false;
+  ensure_scanned();
+  // There is one handle for each loadable library.
+  return lib_ptr_map_.find(path) != lib_ptr_map_.cend();
 }
 
 void
-cet::LibraryManager::lib_loc_map_inserter(std::string const& path)
+cet::LibraryManager::lib_loc_map_inserter(lib_loc_map_t& lib_loc_map,
+                                          std::string const& path)
 {
-  lib_loc_map_[boost::filesystem::path(path).filename().native()] = path;
+  lib_loc_map[boost::filesystem::path(path).filename().native()] = path;
 }
 
 void
 cet::LibraryManager::spec_trans_map_inserter(
-  lib_loc_map_t::value_type const& entry)
+  spec_trans_map_t& spec_trans_map,
+  lib_loc_map_t::value_type const& entry) const
 {
   // First obtain short spec.
   boost::regex const e{"([^_]+)_" + lib_type_ + dllExtPattern() + '$'};
   boost::match_results<std::string::const_iterator> match_results;
   if (boost::regex_search(entry.first, match_results, e)) {
-    spec_trans_map_[match_results[1]].insert(entry.second);
+    spec_trans_map[match_results[1]].insert(entry.second);
   } else {
     throw exception("LogicError")
       << "Internal error in spec_trans_map_inserter for entry " << entry.first
@@ -183,7 +247,7 @@ cet::LibraryManager::spec_trans_map_inserter(
   boost::regex const stripper{"^lib(.*)/" + lib_type_ + "\\..*$"};
   std::string const lib_name_str{lib_name.str()};
   if (boost::regex_search(lib_name_str, match_results, stripper)) {
-    spec_trans_map_[match_results[1]].insert(entry.second);
+    spec_trans_map[match_results[1]].insert(entry.second);
   } else {
     throw exception("LogicError")
       << "Internal error in spec_trans_map_inserter stripping "
@@ -193,31 +257,95 @@ cet::LibraryManager::spec_trans_map_inserter(
 
 void
 cet::LibraryManager::good_spec_trans_map_inserter(
+  good_spec_trans_map_t& good_spec_trans_map,
   spec_trans_map_t::value_type const& entry)
 {
   if (entry.second.size() == 1) {
-    good_spec_trans_map_[entry.first] = *(entry.second.begin());
+    good_spec_trans_map[entry.first] = *(entry.second.begin());
+  }
+}
+
+cet::LibraryManager::lib_handle&
+cet::LibraryManager::get_lib_handle(std::string const& lib_loc) const
+{
+  ensure_scanned();
+  // Handles of loadable libraries are created at construction time,
+  // so no lock is required to find them.
+  if (auto const it = lib_ptr_map_.find(lib_loc); it != lib_ptr_map_.end()) {
+    return it->second;
   }
+  // Map nodes are stable, so the returned reference remains valid
+  // after the lock is released.
+  std::lock_guard sentry{extra_lib_ptr_mutex_};
+  return extra_lib_ptr_map_[lib_loc];
 }
 
 void*
 cet::LibraryManager::get_lib_ptr(std::string const& lib_loc) const
 {
-  lib_ptr_map_t::const_iterator const it{lib_ptr_map_.find(lib_loc)};
-  if (it == lib_ptr_map_.cend() || it->second == nullptr) {
-    dlerror();
-    void* ptr = dlopen(lib_loc.c_str(), RTLD_LAZY | RTLD_GLOBAL);
-    lib_ptr_map_[lib_loc] = ptr;
+  auto& handle = get_lib_handle(lib_loc);
+  // Fast path: the library has already been loaded.
+  if (void* const ptr = handle.ptr.load(std::memory_order_acquire)) {
     return ptr;
   }
-  return it->second;
+  // Slow path: only one thread at a time may attempt to load a given
+  // library; the others find the published pointer once it is
+  // released.  A failed load is retried on the next request, and the
+  // dlerror() state is available to the thread that attempted it.
+  std::lock_guard sentry{handle.load_mutex};
+  void* ptr = handle.ptr.load(std::memory_order_relaxed);
+  if (ptr == nullptr) {
+    PluginLoadTimes::sentry const timing{
+      load_times_if_enabled(), PluginLoadTimes::Stage::Dlopen, lib_loc};
+    dlerror();
+    ptr = dlopen(lib_loc.c_str(), RTLD_LAZY | RTLD_GLOBAL);
+    handle.ptr.store(ptr, std::memory_order_release);
+  }
+  return ptr;
 }
 
-void*
-cet::LibraryManager::getSymbolByLibspec_(std::string const& libspec,
-                                         std::string const& sym_name,
-                                         bool should_throw_on_dlsym) const
+void
+cet::LibraryManager::preload_one(preload_result& result) const try {
+  result.lib_loc = lib_loc_for_libspec(result.libspec);
+  auto const start = std::chrono::steady_clock::now();
+  void* const ptr = get_lib_ptr(result.lib_loc);
+  result.load_time = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  if (ptr == nullptr) {
+    result.error = "Unable to load requested library " + result.lib_loc +
+                   "\n" + demangle_message(dlerror()) + "\n";
+  }
+}
+catch (exception const& e) {
+  result.error = e.what();
+}
+
+std::vector<std::string>
+cet::LibraryManager::loaded_libraries() const
+{
+  ensure_scanned();
+  std::vector<std::string> result;
+  auto collect = [&result](lib_ptr_map_t const& handles) {
+    for (auto const& [path, handle] : handles) {
+      if (handle.ptr.load(std::memory_order_acquire) != nullptr) {
+        result.push_back(path);
+      }
+    }
+  };
+  collect(lib_ptr_map_);
+  {
+    std::lock_guard sentry{extra_lib_ptr_mutex_};
+    collect(extra_lib_ptr_map_);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::string const&
+cet::LibraryManager::lib_loc_for_libspec(std::string const& libspec) const
 {
+  ensure_scanned();
   if (libspec.find("_") != std::string::npos) {
     // Plugin names (and hence the class name) cannot contain an underscore.
     throw exception("LogicError", "IllegalUnderscore.")
@@ -249,7 +377,16 @@ cet::LibraryManager::getSymbolByLibspec_(std::string const& libspec,
     }
     throw exception("Configuration") << error_msg.str();
   }
-  return getSymbolByPath_(trans->second, sym_name, should_throw_on_dlsym);
+  return trans->second;
+}
+
+void*
+cet::LibraryManager::getSymbolByLibspec_(std::string const& libspec,
+                                         std::string const& sym_name,
+                                         bool should_throw_on_dlsym) const
+{
+  return getSymbolByPath_(
+    lib_loc_for_libspec(libspec), sym_name, should_throw_on_dlsym);
 }
 
 void*
@@ -264,9 +401,16 @@ cet::LibraryManager::getSymbolByPath_(std::string const& lib_loc,
       << "Unable to load requested library " << lib_loc << "\n"
       << demangle_message(dlerror()) << "\n";
   } else { // Found library
-    dlerror();
-    result = dlsym(lib_ptr, sym_name.c_str());
-    char const* error = dlerror();
+    char const* error{nullptr};
+    {
+      PluginLoadTimes::sentry const timing{load_times_if_enabled(),
+                                           PluginLoadTimes::Stage::Dlsym,
+                                           lib_loc,
+                                           sym_name};
+      dlerror();
+      result = dlsym(lib_ptr, sym_name.c_str());
+      error = dlerror();
+    }
     if (error != nullptr) { // Error message
       result = nullptr;
       if (should_throw_on_dlsym) {
@@ -1,12 +1,16 @@
 #ifndef cetlib_LibraryManager_h
 #define cetlib_LibraryManager_h
 
+#include "cetlib/PluginLoadTimes.h"
 #include "cetlib/hard_cast.h"
 #include "cetlib/search_path.h"
 #include "cetlib/shlib_utils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -16,6 +20,26 @@ namespace cet {
   class LibraryManager;
 }
 
+// ======================================================================
+//
+// Thread safety
+// -------------
+//
+// Once constructed, a LibraryManager may be used concurrently from any
+// number of threads.  The search for loadable libraries is deferred
+// until the first call that requires it, so that a LibraryManager that
+// is never consulted costs no filesystem access.  The tables
+// translating library specifications to paths are built once, by that
+// call, and are immutable thereafter.  Each loadable library
+// has its own handle slot: a library that has already been loaded is
+// found without taking any lock, and a library that has not yet been
+// loaded is dlopen'ed exactly once, even if several threads request
+// it simultaneously.  Only libraries requested via getSymbolByPath
+// that were not found during the initial search require a (briefly
+// held) lock on a shared table.
+//
+// ======================================================================
+
 class cet::LibraryManager {
 public:
   // Create a LibraryManager that searches through a search path
@@ -39,6 +63,10 @@ public:
   // do in C++. Use the compiler-generated default destructor.
   ~LibraryManager();
 
+  // Not copyable: the library handle slots carry synchronization state.
+  LibraryManager(LibraryManager const&) = delete;
+  LibraryManager& operator=(LibraryManager const&) = delete;
+
   // Find and return a symbol named 'sym_name' in the library
   // identified by 'libspec'. The library is dynamically loaded if
   // necessary. If more than one library matching libspec is found, an
@@ -95,7 +123,8 @@ public:
   size_t getLoadableLibraries(OutIter dest) const;
 
   // Get a list of already-loaded libraries (full paths). Returns the
-  // number of entries.
+  // number of entries. Libraries whose loading was attempted but
+  // failed are not listed.
   size_t getLoadedLibraries(std::vector<std::string>& list) const;
   template <class OutIter>
   size_t getLoadedLibraries(OutIter dest) const;
@@ -113,13 +142,36 @@ public:
   // Load all libraries at once.
   void loadAllLibraries() const;
 
-  // Check whether libraries are loaded.
+  // Load the libraries corresponding to the given libspecs using up to
+  // nthreads concurrent threads (0 => one per hardware thread), so
+  // that their relocation and static-initialization costs overlap.
+  // No exception is thrown for a libspec that cannot be translated or
+  // loaded: the error is instead recorded in the corresponding entry
+  // of the returned vector, whose order matches that of libspecs.
+  struct preload_result {
+    std::string libspec;
+    std::string lib_loc{};  // Empty if libspec could not be translated.
+    double load_time{};     // Wall-clock time (s) to load the library.
+    std::string error{};    // Empty on success.
+  };
+  std::vector<preload_result> preload(std::vector<std::string> const& libspecs,
+                                      unsigned nthreads = 0) const;
+
+  // Check whether libraries are loaded. As for getLoadedLibraries, a
+  // library whose loading failed is not loaded.
   bool libraryIsLoaded(std::string const& path) const;
-  // Check whether library is loadable. Note this is *not* efficient
-  // and is only intended for diagnostic purposes. If it needs to be
-  // efficient the implementation will need to be improved.
+  // Check whether library is loadable, i.e. was found by the directory
+  // scan: a map lookup.
   bool libraryIsLoadable(std::string const& path) const;
 
+  // Optional recording of the times spent loading libraries and
+  // looking up symbols (see cetlib/PluginLoadTimes.h). Recording is
+  // disabled by default; the (one-off) directory scan is always
+  // recorded.
+  void setLoadTimesEnabled(bool enabled);
+  bool loadTimesEnabled() const;
+  PluginLoadTimes& loadTimes() const;
+
   // This manager's library type.
   std::string
   libType() const
@@ -138,16 +190,35 @@ private:
   // Internally-useful type aliases.
   using lib_loc_map_t = std::map<std::string, std::string>;
   using spec_trans_map_t = std::map<std::string, std::set<std::string>>;
-  using lib_ptr_map_t = std::map<std::string, void*>;
   using good_spec_trans_map_t = std::map<std::string, std::string>;
 
+  // Handle of a (possibly not-yet-loaded) library.  The pointer is
+  // published only after a successful dlopen; load_mutex serializes
+  // load attempts so that each library is dlopen'ed at most once.
+  struct lib_handle {
+    std::atomic<void*> ptr{nullptr};
+    std::mutex load_mutex{};
+  };
+  using lib_ptr_map_t = std::map<std::string, lib_handle>;
+
   // Private helper functions.
   static std::string dllExtPattern();
 
-  void lib_loc_map_inserter(std::string const& path);
-  void spec_trans_map_inserter(lib_loc_map_t::value_type const& entry);
-  void good_spec_trans_map_inserter(spec_trans_map_t::value_type const& entry);
+  void ensure_scanned() const;
+  void scan() const;
+  static void lib_loc_map_inserter(lib_loc_map_t& lib_loc_map,
+                                   std::string const& path);
+  void spec_trans_map_inserter(spec_trans_map_t& spec_trans_map,
+                               lib_loc_map_t::value_type const& entry) const;
+  static void good_spec_trans_map_inserter(
+    good_spec_trans_map_t& good_spec_trans_map,
+    spec_trans_map_t::value_type const& entry);
+  lib_handle& get_lib_handle(std::string const& lib_loc) const;
   void* get_lib_ptr(std::string const& lib_loc) const;
+  std::string const& lib_loc_for_libspec(std::string const& libspec) const;
+  void preload_one(preload_result& result) const;
+  PluginLoadTimes* load_times_if_enabled() const;
+  std::vector<std::string> loaded_libraries() const;
   void* getSymbolByLibspec_(std::string const& libspec,
                             std::string const& sym_name,
                             bool should_throw_on_dlsym = true) const;
@@ -158,16 +229,51 @@ private:
   cet::search_path const search_path_;
   std::string const lib_type_;     // eg _plugin.
   std::string const pattern_stem_; // Library search pattern stem.
+  // The following tables are filled exactly once, by a scan() that
+  // completes.
+  mutable std::once_flag scanned_{};
   // Map of library filename -> full path.
-  lib_loc_map_t lib_loc_map_{};
+  mutable lib_loc_map_t lib_loc_map_{};
   // Map of spec -> full path.
-  spec_trans_map_t spec_trans_map_{};
+  mutable spec_trans_map_t spec_trans_map_{};
   // Map of only good translations.
-  good_spec_trans_map_t good_spec_trans_map_{};
-  // Cache of already-loaded libraries.
+  mutable good_spec_trans_map_t good_spec_trans_map_{};
+  // Handles of all loadable libraries.  The map itself is never
+  // modified after the scan, so it may be searched without locking.
   mutable lib_ptr_map_t lib_ptr_map_{};
+  // Handles of libraries requested by path that are not among the
+  // loadable libraries, protected by extra_lib_ptr_mutex_.
+  mutable std::mutex extra_lib_ptr_mutex_{};
+  mutable lib_ptr_map_t extra_lib_ptr_map_{};
+  // Load-time instrumentation.
+  std::atomic<bool> load_times_enabled_{false};
+  mutable PluginLoadTimes load_times_{};
 };
 
+inline void
+cet::LibraryManager::setLoadTimesEnabled(bool const enabled)
+{
+  load_times_enabled_ = enabled;
+}
+
+inline bool
+cet::LibraryManager::loadTimesEnabled() const
+{
+  return load_times_enabled_.load(std::memory_order_relaxed);
+}
+
+inline cet::PluginLoadTimes&
+cet::LibraryManager::loadTimes() const
+{
+  return load_times_;
+}
+
+inline cet::PluginLoadTimes*
+cet::LibraryManager::load_times_if_enabled() const
+{
+  return loadTimesEnabled() ? &load_times_ : nullptr;
+}
+
 inline std::string
 cet::LibraryManager::dllExtPattern()
 {
@@ -209,10 +315,17 @@ cet::LibraryManager::getSymbolByPath(std::string const& lib_loc,
   hard_cast<T>(getSymbolByPath_(lib_loc, sym_name), sym);
 }
 
+inline void
+cet::LibraryManager::ensure_scanned() const
+{
+  std::call_once(scanned_, [this] { scan(); });
+}
+
 template <class OutIter>
 size_t
 cet::LibraryManager::getLoadableLibraries(OutIter dest) const
 {
+  ensure_scanned();
   size_t count{};
   for (auto const& lib_loc : lib_loc_map_) {
     *dest++ = lib_loc.second;
@@ -264,18 +377,16 @@ template <class OutIter>
 size_t
 cet::LibraryManager::getLoadedLibraries(OutIter dest) const
 {
-  size_t count{};
-  for (auto const& lib_ptr : lib_ptr_map_) {
-    *dest++ = lib_ptr.first;
-    ++count;
-  }
-  return count;
+  auto const loaded = loaded_libraries();
+  std::copy(loaded.cbegin(), loaded.cend(), dest);
+  return loaded.size();
 }
 
 template <class OutIter>
 size_t
 cet::LibraryManager::getValidLibspecs(OutIter dest) const
 {
+  ensure_scanned();
   size_t count{};
   for (auto const& spec_trans : spec_trans_map_) {
     *dest++ = spec_trans.first;
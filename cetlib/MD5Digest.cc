@@ -125,12 +125,24 @@ namespace cet {
     this->append(s);
   }
 
+  MD5Digest::MD5Digest(void const* const data, std::size_t const size)
+    : context_()
+  {
+    MD5_Init(&context_);
+    update(data, size);
+  }
+
   void
   MD5Digest::append(std::string const& s)
   {
-    using md5_byte_t = unsigned char;
-    md5_byte_t const* data = reinterpret_cast<md5_byte_t const*>(s.data());
-    MD5_Update(&context_, const_cast<md5_byte_t*>(data), s.size());
+    update(s.data(), s.size());
+  }
+
+  MD5Digest&
+  MD5Digest::update(void const* const data, std::size_t const size)
+  {
+    MD5_Update(&context_, data, size);
+    return *this;
   }
 
   MD5Result
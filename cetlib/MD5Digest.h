@@ -1,6 +1,7 @@
 #ifndef cetlib_MD5Digest_h
 #define cetlib_MD5Digest_h
 
+#include <cstddef>
 #include <iosfwd>
 #include <ostream>
 #include <string>
@@ -23,7 +24,9 @@ namespace cet {
     // This is the MD5 digest.
     unsigned char bytes[16];
 
-    // Convert the digest to a printable string (the 'hexdigest')
+    // Convert the digest to a printable string (the 'hexdigest'). For
+    // a non-allocating equivalent, see cet::to_hex(bytes) in
+    // cetlib/evp_digest.h.
     std::string toString() const;
 
     // The MD5 digest (not hexdigest) in string form
@@ -59,8 +62,10 @@ namespace cet {
   public:
     MD5Digest();
     explicit MD5Digest(std::string const& s);
+    MD5Digest(void const* data, std::size_t size);
 
     void append(std::string const& s);
+    MD5Digest& update(void const* data, std::size_t size);
     MD5Result digest() const;
 
   private:
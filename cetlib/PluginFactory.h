@@ -14,6 +14,11 @@
 // in the event of a failure. In a future enhancement this will likely
 // be obtained from the plugin library itself where available.
 //
+// Functions of plugins linked statically into the program and
+// registered via cet::static_plugin_registry are found without
+// consulting the LibraryManager (and hence without any library search
+// or dlopen).
+//
 // Note that due to the nature of the C functions which find symbols in
 // dynamic libraries, there is no type safety: a found symbol of the
 // correct name will be coerced to the desired function type. If that
@@ -21,7 +26,10 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "cetlib/LibraryManager.h"
+#include "cetlib/PluginLoadTimes.h"
 #include "cetlib/detail/wrapLibraryManagerException.h"
+#include "cetlib/hard_cast.h"
+#include "cetlib/static_plugin_registry.h"
 #include "cetlib_except/exception.h"
 
 #include <functional>
@@ -42,6 +50,12 @@ public:
   void setDiagReleaseVersion(std::string const& rv);
   void setDiagReleaseVersion(std::function<std::string()> rvf);
 
+  // Optional recording of the times spent loading plugin libraries,
+  // looking up symbols, and calling plugin functions via call() (see
+  // cetlib/PluginLoadTimes.h).
+  void setLoadTimesEnabled(bool enabled);
+  PluginLoadTimes const& loadTimes() const;
+
   // General function to find and call a named function from the
   // specified plugin library. RESULT_TYPE must be specified; ARGS may
   // be deduced.
@@ -83,6 +97,8 @@ private:
                              std::string const& funcname,
                              T& symbol) const;
 
+  void* findStatic_(std::string const& libspec,
+                    std::string const& funcname) const;
   std::string releaseVersion_() const;
 
   LibraryManager lm_;
@@ -102,14 +118,40 @@ cet::PluginFactory::setDiagReleaseVersion(std::string const& rv)
   releaseVersionString_ = rv;
 }
 
+inline void
+cet::PluginFactory::setLoadTimesEnabled(bool const enabled)
+{
+  lm_.setLoadTimesEnabled(enabled);
+}
+
+inline cet::PluginLoadTimes const&
+cet::PluginFactory::loadTimes() const
+{
+  return lm_.loadTimes();
+}
+
+inline void*
+cet::PluginFactory::findStatic_(std::string const& libspec,
+                                std::string const& funcname) const
+{
+  return static_plugin_registry::empty() ?
+           nullptr :
+           static_plugin_registry::find(lm_.libType(), libspec, funcname);
+}
+
 template <typename RESULT_TYPE, typename... ARGS>
 inline RESULT_TYPE
 cet::PluginFactory::call(std::string const& libspec,
                          std::string const& funcname,
                          ARGS&&... args) const
 {
-  return (*find<RESULT_TYPE, ARGS...>(libspec, funcname))(
-    std::forward<ARGS>(args)...);
+  auto const func = find<RESULT_TYPE, ARGS...>(libspec, funcname);
+  PluginLoadTimes::sentry const timing{
+    lm_.loadTimesEnabled() ? &lm_.loadTimes() : nullptr,
+    PluginLoadTimes::Stage::PluginCall,
+    libspec,
+    funcname};
+  return (*func)(std::forward<ARGS>(args)...);
 }
 
 template <typename FUNCTION_TYPE>
@@ -140,6 +182,9 @@ cet::PluginFactory::find(std::string const& libspec,
                          LibraryManager::nothrow_t nothrow) const
   -> RESULT_TYPE (*)(ARGS...)
 {
+  if (void* const address = findStatic_(libspec, funcname)) {
+    return hard_cast<RESULT_TYPE (*)(ARGS...)>(address);
+  }
   return lm_.getSymbolByLibspec<RESULT_TYPE (*)(ARGS...)>(
     libspec, funcname, nothrow);
 }
@@ -150,6 +195,10 @@ cet::PluginFactory::resolveSymbolOrThrow_(std::string const& libspec,
                                           std::string const& funcname,
                                           T& symbol) const
 {
+  if (void* const address = findStatic_(libspec, funcname)) {
+    hard_cast(address, symbol);
+    return;
+  }
   try {
     lm_.getSymbolByLibspec(libspec, funcname, symbol);
   }
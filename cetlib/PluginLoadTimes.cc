@@ -0,0 +1,144 @@
+#include "cetlib/PluginLoadTimes.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+using cet::PluginLoadTimes;
+
+// ----------------------------------------------------------------------
+// sentry
+
+PluginLoadTimes::sentry::sentry(PluginLoadTimes* const times,
+                                Stage const stage,
+                                std::string const& library,
+                                std::string const& symbol)
+  : times_{times}
+  , stage_{stage}
+  , library_{times == nullptr ? std::string{} : library}
+  , symbol_{times == nullptr ? std::string{} : symbol}
+{
+  if (times_ != nullptr) {
+    timer_.start();
+  }
+}
+
+PluginLoadTimes::sentry::~sentry() noexcept
+{
+  if (times_ == nullptr) {
+    return;
+  }
+  try {
+    timer_.stop();
+    times_->record(stage_, std::move(library_), std::move(symbol_), timer_);
+  }
+  catch (...) {
+    // Instrumentation must never interfere with plugin loading.
+  }
+}
+
+// ----------------------------------------------------------------------
+// PluginLoadTimes
+
+void
+PluginLoadTimes::record(Stage const stage,
+                        std::string library,
+                        std::string symbol,
+                        cpu_timer const& timer)
+{
+  Entry entry{stage,
+              std::move(library),
+              std::move(symbol),
+              timer.accumulated_real_time(),
+              timer.accumulated_cpu_time()};
+  std::lock_guard sentry{mutex_};
+  entries_.push_back(std::move(entry));
+}
+
+void
+PluginLoadTimes::clear()
+{
+  std::lock_guard sentry{mutex_};
+  entries_.clear();
+}
+
+std::vector<PluginLoadTimes::Entry>
+PluginLoadTimes::entries() const
+{
+  std::lock_guard sentry{mutex_};
+  return entries_;
+}
+
+double
+PluginLoadTimes::total_real_time(Stage const stage) const
+{
+  std::lock_guard sentry{mutex_};
+  double result{};
+  for (auto const& entry : entries_) {
+    if (entry.stage == stage) {
+      result += entry.real_time;
+    }
+  }
+  return result;
+}
+
+double
+PluginLoadTimes::total_cpu_time(Stage const stage) const
+{
+  std::lock_guard sentry{mutex_};
+  double result{};
+  for (auto const& entry : entries_) {
+    if (entry.stage == stage) {
+      result += entry.cpu_time;
+    }
+  }
+  return result;
+}
+
+void
+PluginLoadTimes::print(std::ostream& os) const
+{
+  auto sorted = entries();
+  std::stable_sort(
+    sorted.begin(), sorted.end(), [](Entry const& a, Entry const& b) {
+      return a.real_time > b.real_time;
+    });
+  os << std::left << std::setw(14) << "Stage" << std::right << std::setw(12)
+     << "Real (s)" << std::setw(12) << "CPU (s)"
+     << "  Library [symbol]\n";
+  for (auto const& entry : sorted) {
+    os << std::left << std::setw(14) << to_string(entry.stage) << std::right
+       << std::setw(12) << entry.real_time << std::setw(12) << entry.cpu_time
+       << "  " << entry.library;
+    if (!entry.symbol.empty()) {
+      os << " [" << entry.symbol << ']';
+    }
+    os << '\n';
+  }
+}
+
+// ----------------------------------------------------------------------
+// free functions
+
+std::string
+cet::to_string(PluginLoadTimes::Stage const stage)
+{
+  switch (stage) {
+  case PluginLoadTimes::Stage::DirectoryScan:
+    return "DirectoryScan";
+  case PluginLoadTimes::Stage::Dlopen:
+    return "Dlopen";
+  case PluginLoadTimes::Stage::Dlsym:
+    return "Dlsym";
+  case PluginLoadTimes::Stage::PluginCall:
+    return "PluginCall";
+  }
+  return "Unknown";
+}
+
+std::ostream&
+cet::operator<<(std::ostream& os, PluginLoadTimes const& times)
+{
+  times.print(os);
+  return os;
+}
@@ -0,0 +1,102 @@
+#ifndef cetlib_PluginLoadTimes_h
+#define cetlib_PluginLoadTimes_h
+////////////////////////////////////////////////////////////////////////
+// PluginLoadTimes
+//
+// Thread-safe record of the wall-clock and CPU times spent in the
+// stages of locating, loading and using plugin libraries:
+//
+//   DirectoryScan: search for loadable libraries (first LibraryManager use);
+//   Dlopen:        loading of a library;
+//   Dlsym:         lookup of a symbol in a loaded library;
+//   PluginCall:    call of a plugin function (e.g. makePlugin) via
+//                  PluginFactory::call.
+//
+// For DirectoryScan entries, the library field holds the search path;
+// for PluginCall entries, it holds the libspec; otherwise it holds the
+// full path of the library.  The symbol field is empty for
+// DirectoryScan and Dlopen entries.
+//
+// Times are measured with cet::cpu_timer, so CPU times are those of
+// the whole process during the measured interval.
+//
+// Recording is enabled via LibraryManager::setLoadTimesEnabled (or the
+// corresponding PluginFactory function). For writing the entries to an
+// SQLite database, see cetlib/write_plugin_load_times.h.
+////////////////////////////////////////////////////////////////////////
+
+#include "cetlib/cpu_timer.h"
+
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cet {
+  class PluginLoadTimes;
+}
+
+class cet::PluginLoadTimes {
+public:
+  enum class Stage { DirectoryScan, Dlopen, Dlsym, PluginCall };
+
+  struct Entry {
+    Stage stage;
+    std::string library;
+    std::string symbol;
+    double real_time; // Seconds.
+    double cpu_time;  // Seconds.
+  };
+
+  // Times the enclosing scope and records the result on destruction.
+  // A null PluginLoadTimes pointer (i.e. recording disabled) makes the
+  // sentry a no-op.
+  class sentry {
+  public:
+    sentry(PluginLoadTimes* times,
+           Stage stage,
+           std::string const& library,
+           std::string const& symbol = {});
+    ~sentry() noexcept;
+
+    sentry(sentry const&) = delete;
+    sentry& operator=(sentry const&) = delete;
+
+  private:
+    PluginLoadTimes* times_;
+    Stage stage_;
+    std::string library_;
+    std::string symbol_;
+    cpu_timer timer_{};
+  };
+
+  void record(Stage stage,
+              std::string library,
+              std::string symbol,
+              cpu_timer const& timer);
+  void clear();
+
+  // A snapshot of the entries recorded so far, in order of recording.
+  std::vector<Entry> entries() const;
+
+  double total_real_time(Stage stage) const;
+  double total_cpu_time(Stage stage) const;
+
+  // Print the entries, in decreasing order of wall-clock time.
+  void print(std::ostream& os) const;
+
+private:
+  mutable std::mutex mutex_{};
+  std::vector<Entry> entries_{};
+};
+
+namespace cet {
+  std::string to_string(PluginLoadTimes::Stage stage);
+  std::ostream& operator<<(std::ostream& os, PluginLoadTimes const& times);
+}
+
+#endif /* cetlib_PluginLoadTimes_h */
+
+// Local Variables:
+// mode: c++
+// End:
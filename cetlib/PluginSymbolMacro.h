@@ -0,0 +1,33 @@
+#ifndef cetlib_PluginSymbolMacro_h
+#define cetlib_PluginSymbolMacro_h
+
+// =====================================================================
+//
+// CET_PLUGIN_SYMBOL(name): the name under which a plugin's extern "C"
+// function is defined.
+//
+// For a plugin built as a shared library, this is simply name, to be
+// found via dlsym.  For a plugin linked statically into a program via
+// the cet_static_plugin_registry() CMake function (see
+// cetlib/static_plugin_registry.h), CET_STATIC_PLUGIN_PREFIX is defined
+// for the plugin's sources and the name is prefixed with it, so that
+// the same function may be provided by several plugins in the same
+// program.
+//
+// =====================================================================
+
+#ifdef CET_STATIC_PLUGIN_PREFIX
+#define CET_PLUGIN_SYMBOL_CONCAT_DETAIL(prefix, name) prefix##_##name
+#define CET_PLUGIN_SYMBOL_CONCAT(prefix, name)                                 \
+  CET_PLUGIN_SYMBOL_CONCAT_DETAIL(prefix, name)
+#define CET_PLUGIN_SYMBOL(name)                                                \
+  CET_PLUGIN_SYMBOL_CONCAT(CET_STATIC_PLUGIN_PREFIX, name)
+#else
+#define CET_PLUGIN_SYMBOL(name) name
+#endif
+
+#endif /* cetlib_PluginSymbolMacro_h */
+
+// Local Variables:
+// mode: c++
+// End:
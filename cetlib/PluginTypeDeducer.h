@@ -21,6 +21,7 @@
 // answer with a known value to verify the type of the plugin found.
 ////////////////////////////////////////////////////////////////////////
 
+#include "cetlib/PluginSymbolMacro.h"
 #include "cetlib/compiler_macros.h"
 
 #include <string>
@@ -33,7 +34,10 @@ namespace cet {
 
 #define DEFINE_BASIC_PLUGINTYPE_FUNC(base)                                     \
   EXTERN_C_FUNC_DECLARE_START                                                  \
-  std::string pluginType() { return cet::PluginTypeDeducer<base>::value; }     \
+  std::string CET_PLUGIN_SYMBOL(pluginType)()                                  \
+  {                                                                            \
+    return cet::PluginTypeDeducer<base>::value;                                \
+  }                                                                            \
   EXTERN_C_FUNC_DECLARE_END
 
 namespace cet {
@@ -7,6 +7,7 @@
 //
 // =====================================================================
 
+#include "cetlib/PluginSymbolMacro.h"
 #include "cetlib/compiler_macros.h"
 #include "cetlib/detail/provide_file_path.h"
 
@@ -14,7 +15,7 @@
 
 #define CET_PROVIDE_FILE_PATH()                                                \
   EXTERN_C_FUNC_DECLARE_START                                                  \
-  std::string get_source_location()                                            \
+  std::string CET_PLUGIN_SYMBOL(get_source_location)()                         \
   {                                                                            \
     return cet::detail::provide_file_path(__FILE__);                           \
   }                                                                            \
@@ -1,10 +1,12 @@
 #ifndef cetlib_ProvideMakePluginMacros_h
 #define cetlib_ProvideMakePluginMacros_h
 
+#include "cetlib/PluginSymbolMacro.h"
 #include "cetlib/compiler_macros.h"
 
 #define MAKE_PLUGIN_START(result_type, ...)                                    \
-  EXTERN_C_FUNC_DECLARE_START result_type makePlugin(__VA_ARGS__)
+  EXTERN_C_FUNC_DECLARE_START result_type CET_PLUGIN_SYMBOL(makePlugin)(       \
+    __VA_ARGS__)
 #define MAKE_PLUGIN_END EXTERN_C_FUNC_DECLARE_END
 
 #endif /* cetlib_ProvideMakePluginMacros_h */
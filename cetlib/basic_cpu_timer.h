@@ -0,0 +1,180 @@
+#ifndef cetlib_basic_cpu_timer_h
+#define cetlib_basic_cpu_timer_h
+
+// ======================================================================
+//
+// basic_cpu_timer<RealClock, CpuClock>: Measure the cpu and wallclock
+//                                       elapsed times with the given
+//                                       clocks
+//
+// The interface is that of cpu_timer, which reads gettimeofday() and
+// getrusage(), with microsecond resolution.  basic_cpu_timer reads the
+// clocks of timer_clocks.h instead, with nanosecond resolution and at
+// lower cost, and accumulates times as exact tick counts.  The
+// predefined timers are
+//
+//   fast_cpu_timer: monotonic_clock and thread_cpu_clock;
+//   tsc_cpu_timer:  tsc_clock and thread_cpu_clock.
+//
+// Both measure the CPU time of the calling thread only, so must be
+// started, read and stopped on one thread.  Use process_cpu_clock for
+// the CPU time of the whole process, as cpu_timer measures it.
+//
+// ======================================================================
+
+#include "cetlib/timer_clocks.h"
+
+namespace cet {
+  template <class RealClock, class CpuClock>
+  class basic_cpu_timer;
+
+  using fast_cpu_timer = basic_cpu_timer<monotonic_clock, thread_cpu_clock>;
+  using tsc_cpu_timer = basic_cpu_timer<tsc_clock, thread_cpu_clock>;
+}
+
+// ======================================================================
+
+template <class RealClock, class CpuClock>
+class cet::basic_cpu_timer {
+public:
+  using real_clock = RealClock;
+  using cpu_clock = CpuClock;
+
+  basic_cpu_timer() = default;
+
+  // Allow move
+  basic_cpu_timer(basic_cpu_timer&&) = default;
+  basic_cpu_timer& operator=(basic_cpu_timer&&) = default;
+
+  // Disable copy
+  basic_cpu_timer(basic_cpu_timer const&) = delete;
+  basic_cpu_timer& operator=(basic_cpu_timer const&) = delete;
+
+  // --- accessors:
+  bool
+  is_running() const noexcept
+  {
+    return is_running_;
+  }
+  bool
+  is_stopped() const noexcept
+  {
+    return !is_running();
+  }
+  double elapsed_real_time() const noexcept;
+  double elapsed_cpu_time() const noexcept;
+  double accumulated_real_time() const noexcept;
+  double accumulated_cpu_time() const noexcept;
+
+  double
+  realTime() const noexcept
+  {
+    return accumulated_real_time();
+  }
+  double
+  cpuTime() const noexcept
+  {
+    return accumulated_cpu_time();
+  }
+
+  // --- mutators:
+  void start() noexcept;
+  void stop() noexcept;
+  void reset() noexcept;
+
+private:
+  using real_rep = typename RealClock::rep;
+  using cpu_rep = typename CpuClock::rep;
+
+  // --- state:
+  bool is_running_{false};
+  real_rep start_real_time_{};
+  cpu_rep start_cpu_time_{};
+  real_rep accumulated_real_time_{};
+  cpu_rep accumulated_cpu_time_{};
+
+}; // basic_cpu_timer<>
+
+// ======================================================================
+// accessors:
+
+template <class RealClock, class CpuClock>
+double
+cet::basic_cpu_timer<RealClock, CpuClock>::elapsed_real_time() const noexcept
+{
+  return RealClock::seconds(RealClock::now() - start_real_time_);
+}
+
+template <class RealClock, class CpuClock>
+double
+cet::basic_cpu_timer<RealClock, CpuClock>::elapsed_cpu_time() const noexcept
+{
+  return CpuClock::seconds(CpuClock::now() - start_cpu_time_);
+}
+
+template <class RealClock, class CpuClock>
+double
+cet::basic_cpu_timer<RealClock, CpuClock>::accumulated_real_time() const
+  noexcept
+{
+  auto ticks = accumulated_real_time_;
+  if (is_running()) {
+    ticks += RealClock::now() - start_real_time_;
+  }
+  return RealClock::seconds(ticks);
+}
+
+template <class RealClock, class CpuClock>
+double
+cet::basic_cpu_timer<RealClock, CpuClock>::accumulated_cpu_time() const
+  noexcept
+{
+  auto ticks = accumulated_cpu_time_;
+  if (is_running()) {
+    ticks += CpuClock::now() - start_cpu_time_;
+  }
+  return CpuClock::seconds(ticks);
+}
+
+// ======================================================================
+// mutators:
+
+template <class RealClock, class CpuClock>
+void
+cet::basic_cpu_timer<RealClock, CpuClock>::start() noexcept
+{
+  if (!is_stopped())
+    return;
+  start_real_time_ = RealClock::now();
+  start_cpu_time_ = CpuClock::now();
+  is_running_ = true;
+}
+
+template <class RealClock, class CpuClock>
+void
+cet::basic_cpu_timer<RealClock, CpuClock>::stop() noexcept
+{
+  if (!is_running())
+    return;
+  // Read the CPU clock first, as start() read it last.
+  auto const cpu_now = CpuClock::now();
+  accumulated_real_time_ += RealClock::now() - start_real_time_;
+  accumulated_cpu_time_ += cpu_now - start_cpu_time_;
+  is_running_ = false;
+}
+
+template <class RealClock, class CpuClock>
+void
+cet::basic_cpu_timer<RealClock, CpuClock>::reset() noexcept
+{
+  accumulated_real_time_ = {};
+  accumulated_cpu_time_ = {};
+}
+
+// ======================================================================
+
+#endif /* cetlib_basic_cpu_timer_h */
+
+// Local variables:
+// mode: c++
+// End:
@@ -0,0 +1,115 @@
+#ifndef cetlib_concurrent_registry_h
+#define cetlib_concurrent_registry_h
+
+// ======================================================================
+//
+// concurrent_registry<K,V>: A singleton map<K,V> that may be read and
+//                           extended from many threads at once
+//
+// The interface is that of registry<K,V>.  Entries can be added but
+// never replaced or removed, so references returned by get() stay
+// valid.  get() and iteration never block, even while other threads
+// call put(); see detail/append_only_map.h for the guarantees.
+//
+// ======================================================================
+
+#include "cetlib/detail/append_only_map.h"
+#include "cetlib_except/exception.h"
+
+namespace cet {
+  template <class K, class V>
+  class concurrent_registry;
+}
+
+// ======================================================================
+
+template <class K, class V>
+class cet::concurrent_registry {
+  // non-instantiable (and non-copyable, just in case):
+  concurrent_registry() = delete;
+  concurrent_registry(concurrent_registry const&) = delete;
+  void operator=(concurrent_registry const&) = delete;
+
+  // shorthand:
+  using reg_t = detail::append_only_map<K, V>;
+  using iter_t = typename reg_t::const_iterator;
+
+public:
+  using const_iterator = iter_t;
+
+  static bool
+  empty()
+  {
+    return the_registry_().empty();
+  }
+  static typename reg_t::size_type
+  size()
+  {
+    return the_registry_().size();
+  }
+
+  static const_iterator
+  begin()
+  {
+    return the_registry_().begin();
+  }
+  static const_iterator
+  end()
+  {
+    return the_registry_().end();
+  }
+
+  static void put(K const& key, V const& value);
+
+  static V const& get(K const& key);
+  static bool get(K const& key, V& value) noexcept;
+
+private:
+  // encapsulated singleton:
+  static reg_t&
+  the_registry_()
+  {
+    static reg_t the_registry;
+    return the_registry;
+  }
+
+}; // concurrent_registry<>
+
+// ----------------------------------------------------------------------
+
+template <class K, class V>
+void
+cet::concurrent_registry<K, V>::put(K const& key, V const& value)
+{
+  the_registry_().emplace(key, value);
+}
+
+template <class K, class V>
+V const&
+cet::concurrent_registry<K, V>::get(K const& key)
+{
+  iter_t it = the_registry_().find(key);
+  if (it == the_registry_().end())
+    throw cet::exception("cet::concurrent_registry")
+      << "Key \"" << key << "\" not found in registry";
+  return it->second;
+}
+
+template <class K, class V>
+bool
+cet::concurrent_registry<K, V>::get(K const& key, V& value) noexcept
+{
+  iter_t it = the_registry_().find(key);
+  if (it == the_registry_().end())
+    return false;
+  value = it->second;
+  return true;
+}
+
+// ======================================================================
+
+#endif /* cetlib_concurrent_registry_h */
+
+// Local Variables:
+// mode: c++
+// End:
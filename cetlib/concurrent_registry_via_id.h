@@ -0,0 +1,196 @@
+#ifndef cetlib_concurrent_registry_via_id_h
+#define cetlib_concurrent_registry_via_id_h
+
+// ======================================================================
+//
+// concurrent_registry_via_id<K,V>: A singleton map<K,V> requiring that
+//                                  V::id() exists and yields values of
+//                                  type K, that may be read and
+//                                  extended from many threads at once
+//
+// The interface is that of registry_via_id<K,V>, except that get()
+// without arguments returns the registry's own collection type, which
+// has const iteration, size() and find() like a std::map.  Entries can
+// be added but never replaced or removed, so references returned by
+// get() stay valid.  get() and iteration never block, even while other
+// threads call put(); see detail/append_only_map.h for the guarantees.
+//
+// ======================================================================
+
+#include "cetlib/detail/append_only_map.h"
+#include "cetlib/registry_via_id.h"
+#include "cetlib_except/exception.h"
+
+#include <iterator>
+#include <map>
+#include <type_traits>
+
+namespace cet {
+  template <class K, class V>
+  class concurrent_registry_via_id;
+}
+
+// ======================================================================
+
+template <class K, class V>
+class cet::concurrent_registry_via_id {
+  // non-instantiable (and non-copyable, just in case):
+  concurrent_registry_via_id() = delete;
+  concurrent_registry_via_id(concurrent_registry_via_id const&) = delete;
+  void operator=(concurrent_registry_via_id const&) = delete;
+
+public:
+  using collection_type = detail::append_only_map<K, V>;
+  using key_type = typename collection_type::key_type;
+  using mapped_type = typename collection_type::mapped_type;
+  using value_type = typename collection_type::value_type;
+  using size_type = typename collection_type::size_type;
+  using const_iterator = typename collection_type::const_iterator;
+
+  // observers:
+  static bool
+  empty()
+  {
+    return the_registry_().empty();
+  }
+  static size_type
+  size()
+  {
+    return the_registry_().size();
+  }
+
+  // iterators:
+  static const_iterator
+  begin()
+  {
+    return the_registry_().begin();
+  }
+  static const_iterator
+  end()
+  {
+    return the_registry_().end();
+  }
+  static const_iterator
+  cbegin()
+  {
+    return the_registry_().cbegin();
+  }
+  static const_iterator
+  cend()
+  {
+    return the_registry_().cend();
+  }
+
+  // mutators:
+  // A single V;
+  static typename detail::must_have_id<K, V>::type put(V const& value);
+  // A range of iterator to V.
+  template <class FwdIt>
+  static std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   mapped_type>>
+  put(FwdIt begin, FwdIt end);
+  // A range of iterator to std::pair<K, V>. For each pair, first ==
+  // second.id() is a prerequisite.
+  template <class FwdIt>
+  static std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   value_type>>
+  put(FwdIt begin, FwdIt end);
+  // A std::map, as used by registry_via_id. For each value_type,
+  // first == second.id() is a prerequisite.
+  static void put(std::map<K const, V> const& c);
+
+  // accessors:
+  static collection_type const&
+  get() noexcept
+  {
+    return the_registry_();
+  }
+  static V const& get(K const& key);
+  static bool get(K const& key, V& value) noexcept;
+
+private:
+  // encapsulated singleton:
+  static collection_type&
+  the_registry_()
+  {
+    static collection_type the_registry;
+    return the_registry;
+  }
+
+}; // concurrent_registry_via_id<>
+
+// ----------------------------------------------------------------------
+// put() overloads:
+
+template <class K, class V>
+typename cet::detail::must_have_id<K, V>::type
+cet::concurrent_registry_via_id<K, V>::put(V const& value)
+{
+  K id = value.id();
+  the_registry_().emplace(id, value);
+  return id;
+}
+
+template <class K, class V>
+template <class FwdIt>
+inline auto
+cet::concurrent_registry_via_id<K, V>::put(FwdIt b, FwdIt e)
+  -> std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   mapped_type>>
+{
+  for (; b != e; ++b)
+    put(*b);
+}
+
+template <class K, class V>
+template <class FwdIt>
+inline auto
+cet::concurrent_registry_via_id<K, V>::put(FwdIt b, FwdIt e)
+  -> std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   value_type>>
+{
+  for (; b != e; ++b)
+    the_registry_().insert(*b);
+}
+
+template <class K, class V>
+inline void
+cet::concurrent_registry_via_id<K, V>::put(std::map<K const, V> const& c)
+{
+  put(c.cbegin(), c.cend());
+}
+
+// ----------------------------------------------------------------------
+// get() overloads:
+
+template <class K, class V>
+V const&
+cet::concurrent_registry_via_id<K, V>::get(K const& key)
+{
+  const_iterator it = the_registry_().find(key);
+  if (it == the_registry_().end())
+    throw cet::exception("cet::concurrent_registry_via_id")
+      << "Key \"" << key << "\" not found in registry";
+  return it->second;
+}
+
+template <class K, class V>
+bool
+cet::concurrent_registry_via_id<K, V>::get(K const& key, V& value) noexcept
+{
+  const_iterator it = the_registry_().find(key);
+  if (it == the_registry_().end())
+    return false;
+  value = it->second;
+  return true;
+}
+
+#endif /* cetlib_concurrent_registry_via_id_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,59 @@
+// ======================================================================
+//
+// concurrent_simple_stats: simple_stats that many threads may sample at
+//                          once
+//
+// ======================================================================
+
+#include "cetlib/concurrent_simple_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using cet::concurrent_simple_stats;
+
+namespace {
+  unsigned
+  this_thread_index() noexcept
+  {
+    static std::atomic<unsigned> next_index{0};
+    thread_local unsigned const index =
+      next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+  }
+}
+
+concurrent_simple_stats::concurrent_simple_stats(unsigned const nshards)
+  : nshards_{nshards != 0 ? nshards :
+                            std::max(std::thread::hardware_concurrency(), 1u)}
+  , shards_{std::make_unique<shard[]>(nshards_)}
+{}
+
+cet::simple_stats
+concurrent_simple_stats::snapshot() const
+{
+  simple_stats result;
+  for (unsigned i = 0; i != nshards_; ++i) {
+    std::lock_guard sentry{shards_[i].mutex};
+    result.merge(shards_[i].stats);
+  }
+  return result;
+}
+
+void
+concurrent_simple_stats::sample(double const x) noexcept
+{
+  auto& s = shards_[this_thread_index() % nshards_];
+  std::lock_guard sentry{s.mutex};
+  s.stats.sample(x);
+}
+
+void
+concurrent_simple_stats::reset() noexcept
+{
+  for (unsigned i = 0; i != nshards_; ++i) {
+    std::lock_guard sentry{shards_[i].mutex};
+    shards_[i].stats.reset();
+  }
+}
@@ -0,0 +1,69 @@
+#ifndef cetlib_concurrent_simple_stats_h
+#define cetlib_concurrent_simple_stats_h
+
+// ======================================================================
+//
+// concurrent_simple_stats: simple_stats that many threads may sample at
+//                          once
+//
+// The samples are accumulated in several simple_stats shards, each on
+// its own cache line and guarded by its own mutex.  Each thread is
+// assigned a shard (round robin, on its first sample of any
+// concurrent_simple_stats), so that with at least as many shards as
+// threads, no two threads contend for a lock or a cache line.
+// snapshot() merges the shards into one simple_stats.
+//
+// ======================================================================
+
+#include "cetlib/simple_stats.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace cet {
+  class concurrent_simple_stats;
+}
+
+// ======================================================================
+
+class cet::concurrent_simple_stats {
+public:
+  // By default, one shard per hardware thread.
+  explicit concurrent_simple_stats(unsigned nshards = 0);
+
+  // Disable copy
+  concurrent_simple_stats(concurrent_simple_stats const&) = delete;
+  concurrent_simple_stats& operator=(concurrent_simple_stats const&) =
+    delete;
+
+  unsigned
+  shards() const noexcept
+  {
+    return nshards_;
+  }
+
+  // All samples so far.
+  simple_stats snapshot() const;
+
+  void sample(double x) noexcept;
+  void reset() noexcept;
+
+private:
+  struct alignas(64) shard {
+    mutable std::mutex mutex;
+    simple_stats stats;
+  };
+
+  unsigned nshards_;
+  std::unique_ptr<shard[]> shards_;
+
+}; // concurrent_simple_stats
+
+// ======================================================================
+
+#endif /* cetlib_concurrent_simple_stats_h */
+
+// Local Variables:
+// mode: c++
+// End:
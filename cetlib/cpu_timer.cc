@@ -6,6 +6,7 @@
 
 #include "cetlib/cpu_timer.h"
 
+#include "cetlib/timer_clocks.h"
 #include "cetlib_except/exception.h"
 #include <cerrno>
 #include <sys/resource.h>
@@ -25,18 +26,18 @@ namespace {
     return now;
   }
 
-  timeval
-  cpu_now()
+  double
+  process_cpu_now()
   {
     rusage theUsage;
     if (getrusage(RUSAGE_SELF, &theUsage) != 0) {
       throw exception("cpu_timer", "Failure in get_current_stats") << errno;
     }
 
-    timeval now;
-    now.tv_sec = theUsage.ru_stime.tv_sec + theUsage.ru_utime.tv_sec;
-    now.tv_usec = theUsage.ru_stime.tv_usec + theUsage.ru_utime.tv_usec;
-    return now;
+    double constexpr microsec_per_sec{1E-6};
+    return theUsage.ru_stime.tv_sec + theUsage.ru_utime.tv_sec +
+           (theUsage.ru_stime.tv_usec + theUsage.ru_utime.tv_usec) *
+             microsec_per_sec;
   }
 
   double
@@ -47,6 +48,17 @@ namespace {
   }
 }
 
+// ======================================================================
+// cpu clock:
+
+double
+cpu_timer::cpu_now() const
+{
+  return scope_ == cpu_time_scope::thread ?
+           thread_cpu_clock::seconds(thread_cpu_clock::now()) :
+           process_cpu_now();
+}
+
 // ======================================================================
 // accessors:
 
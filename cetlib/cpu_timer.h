@@ -5,12 +5,22 @@
 //
 // cpu_timer: Measure the cpu and wallclock elapsed times
 //
+// By default the cpu time is that of the whole process, as reported by
+// getrusage(RUSAGE_SELF): in a multithreaded program it includes the
+// work of every thread while the timer runs.  A timer constructed with
+// cpu_time_scope::thread measures only the cpu time of the calling
+// thread (CLOCK_THREAD_CPUTIME_ID).  Such a timer must be started, read
+// and stopped on the same thread: its readings are meaningless
+// otherwise.  Wallclock time is unaffected by the choice.
+//
 // ======================================================================
 
 #include <sys/time.h>
 
 namespace cet {
   class cpu_timer;
+
+  enum class cpu_time_scope { process, thread };
 }
 
 // ======================================================================
@@ -18,6 +28,7 @@ namespace cet {
 class cet::cpu_timer {
 public:
   cpu_timer() = default;
+  explicit cpu_timer(cpu_time_scope scope) noexcept : scope_{scope} {}
 
   // Allow move
   cpu_timer(cpu_timer&&) = default;
@@ -30,6 +41,11 @@ public:
   // --- accessors:
   bool is_running() const;
   bool is_stopped() const;
+  cpu_time_scope
+  scope() const noexcept
+  {
+    return scope_;
+  }
   double elapsed_real_time() const;
   double elapsed_cpu_time() const;
   double accumulated_real_time() const;
@@ -52,10 +68,13 @@ public:
   void reset();
 
 private:
+  double cpu_now() const;
+
   // --- state:
+  cpu_time_scope scope_{cpu_time_scope::process};
   bool is_running_{false};
   timeval start_real_time_{0, 0};
-  timeval start_cpu_time_{0, 0};
+  double start_cpu_time_{};
   double accumulated_real_time_{};
   double accumulated_cpu_time_{};
 
@@ -37,12 +37,258 @@
 // ======================================================================
 
 #include "cetlib/crc32.h"
+#include "cetlib/detail/for_each_range.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CET_CRC32_PCLMUL
+#include <immintrin.h>
+#endif
 
 using cet::crc32;
 
 static_assert(crc32{""}.digest() == 0,
               "Digest for CRC32 of empty string is not 0!");
 
+// ----------------------------------------------------------------------
+// Bulk implementations: each takes and returns the (pre-inverted)
+// context, rather than the digest.
+
+namespace {
+  using update_t = std::uint32_t (*)(std::uint32_t context,
+                                     unsigned char const* data,
+                                     std::size_t size);
+
+  // Tables for slicing-by-16: tables[0] is crc32::crctable, and
+  // tables[k][i] is the CRC of byte i followed by k zero bytes.
+  using slicing_tables_t = std::array<std::array<std::uint32_t, 256>, 16>;
+
+  constexpr slicing_tables_t
+  make_slicing_tables()
+  {
+    slicing_tables_t result{};
+    for (std::uint32_t i = 0; i != 256; ++i) {
+      std::uint32_t c = i;
+      for (int bit = 0; bit != 8; ++bit) {
+        c = (c & 1u) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+      }
+      result[0][i] = c;
+    }
+    for (std::size_t k = 1; k != result.size(); ++k) {
+      for (std::size_t i = 0; i != 256; ++i) {
+        auto const prev = result[k - 1][i];
+        result[k][i] = (prev >> 8) ^ result[0][prev & 0xFFu];
+      }
+    }
+    return result;
+  }
+
+  constexpr slicing_tables_t slicing_tables = make_slicing_tables();
+
+  std::uint32_t
+  update_bytewise(std::uint32_t context,
+                  unsigned char const* data,
+                  std::size_t const size)
+  {
+    auto const& table = slicing_tables[0];
+    for (auto const* const end = data + size; data != end; ++data) {
+      context = table[(context ^ *data) & 0xFFu] ^ (context >> 8);
+    }
+    return context;
+  }
+
+  std::uint32_t
+  load_le32(unsigned char const* const p)
+  {
+    return std::uint32_t{p[0]} | std::uint32_t{p[1]} << 8 |
+           std::uint32_t{p[2]} << 16 | std::uint32_t{p[3]} << 24;
+  }
+
+  std::uint32_t
+  update_slicing16(std::uint32_t context,
+                   unsigned char const* data,
+                   std::size_t size)
+  {
+    auto const& t = slicing_tables;
+    for (; size >= 16; data += 16, size -= 16) {
+      std::uint32_t const a = load_le32(data) ^ context;
+      std::uint32_t const b = load_le32(data + 4);
+      std::uint32_t const c = load_le32(data + 8);
+      std::uint32_t const d = load_le32(data + 12);
+      context = t[15][a & 0xFF] ^ t[14][(a >> 8) & 0xFF] ^
+                t[13][(a >> 16) & 0xFF] ^ t[12][a >> 24] ^ t[11][b & 0xFF] ^
+                t[10][(b >> 8) & 0xFF] ^ t[9][(b >> 16) & 0xFF] ^
+                t[8][b >> 24] ^ t[7][c & 0xFF] ^ t[6][(c >> 8) & 0xFF] ^
+                t[5][(c >> 16) & 0xFF] ^ t[4][c >> 24] ^ t[3][d & 0xFF] ^
+                t[2][(d >> 8) & 0xFF] ^ t[1][(d >> 16) & 0xFF] ^
+                t[0][d >> 24];
+    }
+    return update_bytewise(context, data, size);
+  }
+
+#ifdef CET_CRC32_PCLMUL
+  // Folding with carry-less multiplication, after "Fast CRC Computation
+  // for Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009),
+  // with the constants for the bit-reflected CRC-32 polynomial.
+#define CET_CRC32_TARGET __attribute__((target("pclmul,sse4.1")))
+
+  CET_CRC32_TARGET inline __m128i
+  load(unsigned char const* const p)
+  {
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+  }
+
+  // Fold x forward (using the constants k) onto y.
+  CET_CRC32_TARGET inline __m128i
+  fold(__m128i const x, __m128i const k, __m128i const y)
+  {
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                                       _mm_clmulepi64_si128(x, k, 0x11)),
+                         y);
+  }
+
+  CET_CRC32_TARGET std::uint32_t
+  update_pclmul(std::uint32_t context,
+                unsigned char const* data,
+                std::size_t size)
+  {
+    if (size < 64) {
+      return update_slicing16(context, data, size);
+    }
+    // Fold 64 bytes at a time into four 128-bit accumulators.
+    __m128i x1 = _mm_xor_si128(load(data),
+                               _mm_cvtsi32_si128(static_cast<int>(context)));
+    __m128i x2 = load(data + 16);
+    __m128i x3 = load(data + 32);
+    __m128i x4 = load(data + 48);
+    data += 64;
+    size -= 64;
+    __m128i k = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    for (; size >= 64; data += 64, size -= 64) {
+      x1 = fold(x1, k, load(data));
+      x2 = fold(x2, k, load(data + 16));
+      x3 = fold(x3, k, load(data + 32));
+      x4 = fold(x4, k, load(data + 48));
+    }
+
+    // Fold the four accumulators, then any further 16-byte blocks, into
+    // one.
+    k = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    x1 = fold(x1, k, x2);
+    x1 = fold(x1, k, x3);
+    x1 = fold(x1, k, x4);
+    for (; size >= 16; data += 16, size -= 16) {
+      x1 = fold(x1, k, load(data));
+    }
+
+    // Reduce to 64 bits, then (Barrett reduction) to 32.
+    __m128i const mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k = _mm_set_epi64x(0, 0x0163cd6124);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x00), x2);
+    __m128i const poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    context = static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+
+    return update_slicing16(context, data, size);
+  }
+#undef CET_CRC32_TARGET
+#endif
+
+  update_t
+  select_update()
+  {
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    return update_bytewise;
+#else
+#ifdef CET_CRC32_PCLMUL
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+      return update_pclmul;
+    }
+#endif
+    return update_slicing16;
+#endif
+  }
+
+  std::uint32_t
+  update(std::uint32_t const context,
+         void const* const data,
+         std::size_t const size)
+  {
+    static update_t const impl{select_update()};
+    return impl(context, static_cast<unsigned char const*>(data), size);
+  }
+}
+
+// ----------------------------------------------------------------------
+// Arithmetic on CRCs as polynomials over GF(2) modulo the (reflected)
+// CRC-32 polynomial, as used by zlib's crc32_combine: bit 31 holds the
+// coefficient of x^0.
+
+namespace {
+  constexpr std::uint32_t
+  multmodp(std::uint32_t const a, std::uint32_t b)
+  {
+    std::uint32_t product{};
+    for (std::uint32_t m = 1u << 31; m != 0; m >>= 1) {
+      if (a & m) {
+        product ^= b;
+        if ((a & (m - 1)) == 0) {
+          break;
+        }
+      }
+      b = (b & 1u) ? (b >> 1) ^ 0xEDB88320u : b >> 1;
+    }
+    return product;
+  }
+
+  // x2n_table[k] is x^(2^k) modulo the polynomial.
+  constexpr std::array<std::uint32_t, 32>
+  make_x2n_table()
+  {
+    std::array<std::uint32_t, 32> result{};
+    std::uint32_t p = 1u << 30; // x^1
+    result[0] = p;
+    for (std::size_t k = 1; k != result.size(); ++k) {
+      result[k] = p = multmodp(p, p);
+    }
+    return result;
+  }
+
+  constexpr std::array<std::uint32_t, 32> x2n_table = make_x2n_table();
+
+  // x^(n * 2^k) modulo the polynomial.
+  std::uint32_t
+  x2nmodp(std::uint64_t n, unsigned k)
+  {
+    std::uint32_t p = 1u << 31; // x^0
+    for (; n != 0; n >>= 1, ++k) {
+      if (n & 1) {
+        p = multmodp(x2n_table[k & 31], p);
+      }
+    }
+    return p;
+  }
+
+  constexpr std::size_t min_parallel_chunk{1 << 20};
+}
+
+static_assert(slicing_tables[0][255] == 0x2D02EF8DL,
+              "Slicing tables do not match crc32::crctable!");
+
 // ----------------------------------------------------------------------
 
 constexpr std::uint32_t cet::crc32::crctable[];
@@ -52,13 +298,75 @@ crc32::crc32(std::string const& mesg)
   operator<<(mesg);
 }
 
+crc32::crc32(std::string_view const mesg)
+{
+  operator<<(mesg);
+}
+
+crc32::crc32(void const* const data, std::size_t const size)
+{
+  update(data, size);
+}
+
 crc32&
 crc32::operator<<(std::string const& mesg)
 {
-  for (uchar const ch : mesg) {
-    context = crctable[(context ^ ch) & 0xFFL] ^ (context >> 8);
-  }
+  return update(mesg.data(), mesg.size());
+}
+
+crc32&
+crc32::operator<<(std::string_view const mesg)
+{
+  return update(mesg.data(), mesg.size());
+}
+
+crc32&
+crc32::update(void const* const data, std::size_t const size)
+{
+  context = ::update(context, data, size);
   return *this;
 }
 
+// ----------------------------------------------------------------------
+
+crc32::digest_t
+cet::crc32_combine(crc32::digest_t const crcA,
+                   crc32::digest_t const crcB,
+                   std::uint64_t const lenB)
+{
+  // Appending lenB bytes multiplies A's CRC by x^(8 * lenB).
+  return multmodp(x2nmodp(lenB, 3), crcA) ^ crcB;
+}
+
+crc32::digest_t
+cet::crc32_parallel(std::string_view const buffer, unsigned nthreads)
+{
+  if (nthreads == 0) {
+    nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  std::size_t const nchunks =
+    std::min<std::size_t>(nthreads, buffer.size() / min_parallel_chunk);
+  if (nchunks < 2) {
+    return crc32{buffer}.digest();
+  }
+
+  std::size_t const chunk_size = buffer.size() / nchunks;
+  auto const chunk = [&buffer, chunk_size, nchunks](std::size_t const i) {
+    auto const size = (i + 1 == nchunks) ? buffer.size() - i * chunk_size :
+                                           chunk_size;
+    return buffer.substr(i * chunk_size, size);
+  };
+
+  std::vector<crc32::digest_t> digests(nchunks);
+  detail::for_each_thread(nchunks, [&digests, &chunk](unsigned const i) {
+    digests[i] = crc32{chunk(i)}.digest();
+  });
+
+  auto result = digests[0];
+  for (std::size_t i = 1; i != nchunks; ++i) {
+    result = crc32_combine(result, digests[i], chunk(i).size());
+  }
+  return result;
+}
+
 // ======================================================================
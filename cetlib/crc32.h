@@ -7,8 +7,10 @@
 //
 // ======================================================================
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace cet {
   class crc32;
@@ -21,17 +23,25 @@ public:
   using uchar = unsigned char;
   using digest_t = std::uint32_t;
 
-  // None of the std::string-based member functions (including the
-  // c'tors) can be constexpr.
+  // None of the std::string-, std::string_view- or buffer-based member
+  // functions (including the c'tors) can be constexpr. They process
+  // their input with the fastest implementation available on the
+  // host: carry-less multiplication (PCLMULQDQ) on x86-64 processors
+  // that support it, otherwise slicing-by-16 tables. All produce the
+  // same digests as the byte-at-a-time constexpr functions.
 
   constexpr crc32() = default;
   constexpr explicit crc32(char const* mesg);
   constexpr explicit crc32(char const mesg);
   explicit crc32(std::string const& mesg);
+  explicit crc32(std::string_view mesg);
+  crc32(void const* data, std::size_t size);
 
   constexpr crc32& operator<<(char const* mesg);
   constexpr crc32& operator<<(char const mesg);
   crc32& operator<<(std::string const& mesg);
+  crc32& operator<<(std::string_view mesg);
+  crc32& update(void const* data, std::size_t size);
 
   constexpr digest_t digest() const;
 
@@ -100,6 +110,23 @@ private:
 
 }; // crc32
 
+namespace cet {
+  // The digest of the concatenation of messages A and B, given only
+  // their digests and the length (in bytes) of B.
+  crc32::digest_t crc32_combine(crc32::digest_t crcA,
+                                crc32::digest_t crcB,
+                                std::uint64_t lenB);
+
+  // The digest of buffer, calculated by hashing up to nthreads
+  // contiguous chunks concurrently and combining the results; the
+  // digest is identical to that of a sequential calculation. If
+  // nthreads is 0, std::thread::hardware_concurrency() is used. Chunks
+  // are at least 1 MiB, so small buffers are hashed on the calling
+  // thread only.
+  crc32::digest_t crc32_parallel(std::string_view buffer,
+                                 unsigned nthreads = 0);
+}
+
 // ======================================================================
 // constexpr member-function implementations
 
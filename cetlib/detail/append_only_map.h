@@ -0,0 +1,296 @@
+#ifndef cetlib_detail_append_only_map_h
+#define cetlib_detail_append_only_map_h
+////////////////////////////////////////////////////////////////////////
+// append_only_map
+//
+// An ordered map whose entries, once inserted, are never modified,
+// moved or removed (until the map itself is destroyed).  It is the
+// storage of the concurrent registries.
+//
+// Lookups and iteration never block and may run concurrently with
+// insertions: the entries form a skip list whose links are published
+// with release stores and followed with acquire loads.  Insertions are
+// serialized by a mutex, but the new entry (including the copy of the
+// value) is constructed before the mutex is taken, so only the linking
+// of a few pointers is done under the lock.
+//
+// A lookup or iteration concurrent with an insertion may or may not see
+// the new entry; every entry it does see is complete.  References to
+// entries remain valid for the lifetime of the map.
+////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace cet::detail {
+  template <class K, class V>
+  class append_only_map;
+}
+
+// ======================================================================
+
+template <class K, class V>
+class cet::detail::append_only_map {
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K const, V>;
+  using size_type = std::size_t;
+
+  class const_iterator;
+
+  append_only_map() = default;
+  ~append_only_map();
+
+  // non-copyable:
+  append_only_map(append_only_map const&) = delete;
+  append_only_map& operator=(append_only_map const&) = delete;
+
+  bool
+  empty() const noexcept
+  {
+    return size() == 0;
+  }
+  size_type
+  size() const noexcept
+  {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  const_iterator begin() const noexcept;
+  const_iterator
+  end() const noexcept
+  {
+    return {};
+  }
+  const_iterator
+  cbegin() const noexcept
+  {
+    return begin();
+  }
+  const_iterator
+  cend() const noexcept
+  {
+    return end();
+  }
+
+  // The entry with the given key, or end().
+  const_iterator find(K const& key) const;
+
+  // Insert an entry unless one with the same key is present; returns
+  // the entry with the key, and whether it was inserted.
+  std::pair<const_iterator, bool> insert(value_type const& value);
+  template <class... Args>
+  std::pair<const_iterator, bool> emplace(Args&&... args);
+
+private:
+  // The number of levels of the skip list, and the inverse of the
+  // fraction of entries at each level that also appear in the next:
+  // good for up to 4^max_height entries.
+  static constexpr int max_height{16};
+  static constexpr unsigned branching{4};
+
+  struct node;
+  using link_t = std::atomic<node*>;
+
+  struct node {
+    template <class... Args>
+    node(int const h, Args&&... args)
+      : value(std::forward<Args>(args)...)
+      , height{h}
+      , next{std::make_unique<link_t[]>(h)}
+    {}
+
+    value_type const value;
+    int const height;
+    std::unique_ptr<link_t[]> next;
+  };
+
+  int random_height() noexcept;
+  std::pair<const_iterator, bool> insert_node(std::unique_ptr<node> n);
+
+  link_t head_[max_height]{};
+  std::atomic<size_type> size_{0};
+  std::atomic<std::uint64_t> sequence_{0};
+  std::mutex insert_mutex_;
+
+}; // append_only_map<>
+
+// ======================================================================
+
+template <class K, class V>
+class cet::detail::append_only_map<K, V>::const_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename append_only_map::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = value_type const*;
+  using reference = value_type const&;
+
+  const_iterator() = default;
+
+  reference
+  operator*() const noexcept
+  {
+    return node_->value;
+  }
+  pointer
+  operator->() const noexcept
+  {
+    return &node_->value;
+  }
+
+  const_iterator&
+  operator++() noexcept
+  {
+    node_ = node_->next[0].load(std::memory_order_acquire);
+    return *this;
+  }
+  const_iterator
+  operator++(int) noexcept
+  {
+    auto result = *this;
+    ++*this;
+    return result;
+  }
+
+  friend bool
+  operator==(const_iterator const a, const_iterator const b) noexcept
+  {
+    return a.node_ == b.node_;
+  }
+  friend bool
+  operator!=(const_iterator const a, const_iterator const b) noexcept
+  {
+    return a.node_ != b.node_;
+  }
+
+private:
+  friend class append_only_map;
+  explicit const_iterator(node const* const n) noexcept : node_{n} {}
+
+  node const* node_{nullptr};
+};
+
+// ======================================================================
+
+template <class K, class V>
+cet::detail::append_only_map<K, V>::~append_only_map()
+{
+  auto* n = head_[0].load(std::memory_order_relaxed);
+  while (n != nullptr) {
+    auto* next = n->next[0].load(std::memory_order_relaxed);
+    delete n;
+    n = next;
+  }
+}
+
+template <class K, class V>
+typename cet::detail::append_only_map<K, V>::const_iterator
+cet::detail::append_only_map<K, V>::begin() const noexcept
+{
+  return const_iterator{head_[0].load(std::memory_order_acquire)};
+}
+
+template <class K, class V>
+typename cet::detail::append_only_map<K, V>::const_iterator
+cet::detail::append_only_map<K, V>::find(K const& key) const
+{
+  link_t const* links = head_;
+  node const* candidate{nullptr};
+  for (int level = max_height - 1; level >= 0; --level) {
+    candidate = links[level].load(std::memory_order_acquire);
+    while (candidate != nullptr && candidate->value.first < key) {
+      links = candidate->next.get();
+      candidate = links[level].load(std::memory_order_acquire);
+    }
+  }
+  if (candidate != nullptr && !(key < candidate->value.first)) {
+    return const_iterator{candidate};
+  }
+  return end();
+}
+
+template <class K, class V>
+std::pair<typename cet::detail::append_only_map<K, V>::const_iterator, bool>
+cet::detail::append_only_map<K, V>::insert(value_type const& value)
+{
+  return insert_node(std::make_unique<node>(random_height(), value));
+}
+
+template <class K, class V>
+template <class... Args>
+std::pair<typename cet::detail::append_only_map<K, V>::const_iterator, bool>
+cet::detail::append_only_map<K, V>::emplace(Args&&... args)
+{
+  return insert_node(
+    std::make_unique<node>(random_height(), std::forward<Args>(args)...));
+}
+
+// Geometrically distributed, from a hash of a sequence number so that
+// no lock is needed.
+template <class K, class V>
+int
+cet::detail::append_only_map<K, V>::random_height() noexcept
+{
+  auto x = sequence_.fetch_add(1, std::memory_order_relaxed) +
+           0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+  int height{1};
+  while (height != max_height && x % branching == 0) {
+    ++height;
+    x /= branching;
+  }
+  return height;
+}
+
+template <class K, class V>
+std::pair<typename cet::detail::append_only_map<K, V>::const_iterator, bool>
+cet::detail::append_only_map<K, V>::insert_node(std::unique_ptr<node> n)
+{
+  auto const& key = n->value.first;
+  std::lock_guard lock{insert_mutex_};
+
+  // The link at each level after which the new node belongs.  Only
+  // this thread modifies links, so relaxed loads suffice.
+  link_t* preceding[max_height];
+  link_t* links = head_;
+  for (int level = max_height - 1; level >= 0; --level) {
+    auto* next = links[level].load(std::memory_order_relaxed);
+    while (next != nullptr && next->value.first < key) {
+      links = next->next.get();
+      next = links[level].load(std::memory_order_relaxed);
+    }
+    preceding[level] = &links[level];
+  }
+  if (auto* existing = preceding[0]->load(std::memory_order_relaxed);
+      existing != nullptr && !(key < existing->value.first)) {
+    return {const_iterator{existing}, false};
+  }
+
+  // Link the node in from the bottom up; a reader that finds it at any
+  // level sees its value and all of its lower links.
+  for (int level = 0; level != n->height; ++level) {
+    n->next[level].store(preceding[level]->load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+  }
+  auto* const inserted = n.release();
+  for (int level = 0; level != inserted->height; ++level) {
+    preceding[level]->store(inserted, std::memory_order_release);
+  }
+  size_.fetch_add(1, std::memory_order_release);
+  return {const_iterator{inserted}, true};
+}
+
+#endif /* cetlib_detail_append_only_map_h */
+
+// Local Variables:
+// mode: c++
+// End:
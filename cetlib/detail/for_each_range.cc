@@ -0,0 +1,89 @@
+#include "cetlib/detail/for_each_range.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void
+cet::detail::for_each_thread(unsigned const nthreads,
+                             std::function<void(unsigned)> const& f)
+{
+  if (nthreads < 2) {
+    if (nthreads != 0) {
+      f(0);
+    }
+    return;
+  }
+
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto const work = [&](unsigned const i) {
+    try {
+      f(i);
+    }
+    catch (...) {
+      std::lock_guard lock{error_mutex};
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(nthreads - 1);
+  try {
+    for (unsigned i = 1; i != nthreads; ++i) {
+      workers.emplace_back(work, i);
+    }
+  }
+  catch (...) {
+    // Joinable threads must not be destroyed.
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    throw;
+  }
+  work(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+unsigned
+cet::detail::range_threads(std::size_t const n,
+                           unsigned nthreads,
+                           std::size_t const min_per_thread)
+{
+  if (nthreads == 0) {
+    nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  return static_cast<unsigned>(std::clamp<std::size_t>(
+    n / std::max<std::size_t>(min_per_thread, 1), 1, nthreads));
+}
+
+void
+cet::detail::for_each_range(
+  std::size_t const n,
+  unsigned const nthreads,
+  std::function<void(std::size_t, std::size_t)> const& f)
+{
+  if (nthreads < 2 || n < 2) {
+    if (n != 0) {
+      f(0, n);
+    }
+    return;
+  }
+
+  for_each_thread(nthreads, [n, nthreads, &f](unsigned const i) {
+    auto const begin = n * i / nthreads;
+    auto const end = n * (i + 1) / nthreads;
+    if (begin != end) {
+      f(begin, end);
+    }
+  });
+}
@@ -0,0 +1,41 @@
+#ifndef cetlib_detail_for_each_range_h
+#define cetlib_detail_for_each_range_h
+////////////////////////////////////////////////////////////////////////
+// for_each_range
+//
+// for_each_thread calls f(i) for each i in [0, nthreads), each call on
+// its own thread; the calling thread makes the call with i == 0.  If
+// any call throws, or a thread cannot be started, the first exception
+// is rethrown once all started threads have finished.
+//
+// range_threads gives the number of threads worth using for n indices:
+// at most nthreads (0: the number of hardware threads), with at least
+// min_per_thread indices each.
+//
+// for_each_range splits the indices [0, n) into nthreads contiguous
+// ranges of nearly equal size, and calls f(begin, end) for each range
+// on its own thread (the calling thread takes one of them), using
+// for_each_thread.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <functional>
+
+namespace cet::detail {
+  void for_each_thread(unsigned nthreads,
+                       std::function<void(unsigned)> const& f);
+
+  unsigned range_threads(std::size_t n,
+                         unsigned nthreads,
+                         std::size_t min_per_thread);
+
+  void for_each_range(std::size_t n,
+                      unsigned nthreads,
+                      std::function<void(std::size_t, std::size_t)> const& f);
+}
+
+#endif /* cetlib_detail_for_each_range_h */
+
+// Local Variables:
+// mode: c++
+// End:
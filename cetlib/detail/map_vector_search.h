@@ -0,0 +1,116 @@
+#ifndef cetlib_detail_map_vector_search_h
+#define cetlib_detail_map_vector_search_h
+////////////////////////////////////////////////////////////////////////
+// map_vector_search
+//
+// Key search used by map_vector and soa_map_vector.
+//
+// map_vector keys are unique integers, sorted in increasing order, and
+// usually dense (e.g. track IDs).  Since the keys are strictly
+// increasing, the element at index lo + d has a key of at least
+// key(lo) + d; the search uses this in three stages:
+//
+//   1. Direct index: if key - key(0) is a valid index holding key, it
+//      is the answer (always the case for consecutive keys).
+//   2. Interpolation search narrows the range: each interpolated probe
+//      is followed by a gallop (probes at exponentially growing
+//      distances) to bracket the key, and by a bisection step whenever
+//      the range has not been halved, so badly clustered keys degrade
+//      gracefully towards binary search.
+//   3. The last few candidates are counted without branches.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+namespace cet::detail {
+
+  // Width of the range handed to the final, branchless stage.
+  constexpr std::size_t map_vector_linear_search_max{16};
+
+  // The index of the first of the n elements starting at data whose
+  // key is not less than key; key_of(element) gives the key of an
+  // element as an unsigned long.
+  template <class T, class KeyOf>
+  std::size_t
+  map_vector_lower_bound(T const* const data,
+                         std::size_t const n,
+                         unsigned long const key,
+                         KeyOf const key_of) noexcept
+  {
+    if (n == 0 || key <= key_of(data[0])) {
+      return 0;
+    }
+    std::size_t lo{0}, hi{n - 1};
+    unsigned long klo{key_of(data[lo])}, khi{key_of(data[hi])};
+    if (key > khi) {
+      return n;
+    }
+
+    // Direct index.
+    if (auto const d = key - klo; d < n) {
+      hi = d;
+      khi = key_of(data[d]);
+      if (khi == key) {
+        return d;
+      }
+    }
+
+    // From here on key(lo) < key <= key(hi).  Returns true if p
+    // becomes the lower bound.
+    auto update = [&](std::size_t const p) {
+      auto const kp = key_of(data[p]);
+      if (kp < key) {
+        lo = p;
+        klo = kp;
+        return true;
+      }
+      hi = p;
+      khi = kp;
+      return false;
+    };
+    while (true) {
+      // The answer is at most lo + (key - klo), and more than
+      // hi - (khi - key) - 1.
+      if (key - klo < hi - lo) {
+        hi = lo + (key - klo);
+        khi = key_of(data[hi]);
+      }
+      if (khi - key + 1 < hi - lo) {
+        lo = hi - (khi - key) - 1;
+        klo = key_of(data[lo]);
+      }
+      auto const width = hi - lo;
+      if (width <= map_vector_linear_search_max) {
+        break;
+      }
+      auto const fraction =
+        static_cast<double>(key - klo) / static_cast<double>(khi - klo);
+      auto p = lo + static_cast<std::size_t>(fraction * width);
+      p = p <= lo ? lo + 1 : (p >= hi ? hi - 1 : p);
+
+      // The interpolated index is usually close to the answer, so
+      // gallop away from it to bound the range from the other side.
+      bool const below = update(p);
+      for (std::size_t step = 4; step < hi - lo; step *= 2) {
+        if (update(below ? lo + step : hi - step) != below) {
+          break;
+        }
+      }
+      if (hi - lo > width / 2) {
+        update(lo + (hi - lo) / 2);
+      }
+    }
+
+    std::size_t result{lo + 1};
+    for (std::size_t i = lo + 1; i < hi; ++i) {
+      result += key_of(data[i]) < key;
+    }
+    return result;
+  }
+}
+
+#endif /* cetlib_detail_map_vector_search_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,53 @@
+#include "cetlib/detail/map_vector_sort.h"
+#include "cetlib/detail/for_each_range.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+  // Below this many entries per thread, a single thread is faster.
+  std::size_t constexpr min_entries_per_thread{1u << 16};
+}
+
+void
+cet::detail::sort_map_vector_entries(
+  std::vector<map_vector_sort_entry>& entries,
+  unsigned const max_threads)
+{
+  auto const n = entries.size();
+  auto const nthreads = std::min<std::size_t>(
+    max_threads != 0 ? max_threads :
+                       std::max(std::thread::hardware_concurrency(), 1u),
+    n / min_entries_per_thread);
+  if (nthreads < 2) {
+    std::sort(entries.begin(), entries.end());
+    return;
+  }
+
+  // Sort nthreads chunks concurrently, then merge neighbouring sorted
+  // runs, again concurrently, until one run is left.
+  std::vector<std::size_t> bounds;
+  for (std::size_t i = 0; i != nthreads; ++i) {
+    bounds.push_back(n * i / nthreads);
+  }
+  bounds.push_back(n);
+
+  auto const first = entries.begin();
+  detail::for_each_thread(nthreads, [first, &bounds](unsigned const i) {
+    std::sort(first + bounds[i], first + bounds[i + 1]);
+  });
+  while (bounds.size() > 2) {
+    auto const runs = bounds.size() - 1;
+    detail::for_each_thread(runs / 2, [first, &bounds](unsigned const i) {
+      std::inplace_merge(first + bounds[2 * i],
+                         first + bounds[2 * i + 1],
+                         first + bounds[2 * i + 2]);
+    });
+    std::vector<std::size_t> merged;
+    for (std::size_t i = 0; i < runs; i += 2) {
+      merged.push_back(bounds[i]);
+    }
+    merged.push_back(n);
+    bounds.swap(merged);
+  }
+}
@@ -0,0 +1,31 @@
+#ifndef cetlib_detail_map_vector_sort_h
+#define cetlib_detail_map_vector_sort_h
+////////////////////////////////////////////////////////////////////////
+// map_vector_sort
+//
+// Sorting for map_vector::bulk_insert.  Rather than moving the entries
+// themselves, which may be large, the bulk insertion sorts (key, index)
+// pairs and then moves each entry once, to its final place.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cet::detail {
+
+  // A key, and the index of the entry it came from.
+  using map_vector_sort_entry = std::pair<unsigned long, std::size_t>;
+
+  // Sort by key, then by index, so that the result is the same as for a
+  // stable sort by key.  Large inputs are sorted by up to nthreads
+  // threads (0: the number of hardware threads).
+  void sort_map_vector_entries(std::vector<map_vector_sort_entry>& entries,
+                               unsigned nthreads = 1);
+}
+
+#endif /* cetlib_detail_map_vector_sort_h */
+
+// Local Variables:
+// mode: c++
+// End:
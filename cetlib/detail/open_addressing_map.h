@@ -0,0 +1,373 @@
+#ifndef cetlib_detail_open_addressing_map_h
+#define cetlib_detail_open_addressing_map_h
+////////////////////////////////////////////////////////////////////////
+// open_addressing_map
+//
+// An insert-only hash map, the storage of hashed_registry_via_id.
+//
+// The entries are stored in insertion order in a few large chunks,
+// which are never reallocated, so an insertion allocates no node and
+// references to entries stay valid.  The hash table itself is a
+// linearly-probed array of (hash, entry position) slots, so a lookup
+// usually touches one slot and the entry it finds.
+//
+// As for std::map, find() and emplace() return iterators, and find()
+// returns end() if the key is absent.  find() accepts any key type
+// that Hash and KeyEqual accept; to look up by something other than K,
+// use a transparent Hash and KeyEqual.
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cet::detail {
+  template <class K, class V, class Hash, class KeyEqual>
+  class open_addressing_map;
+}
+
+// ======================================================================
+
+template <class K, class V, class Hash, class KeyEqual>
+class cet::detail::open_addressing_map {
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K const, V>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  class const_iterator;
+
+  open_addressing_map() = default;
+
+  // Not needed for the storage of a singleton registry.
+  open_addressing_map(open_addressing_map const&) = delete;
+  open_addressing_map& operator=(open_addressing_map const&) = delete;
+
+  bool
+  empty() const noexcept
+  {
+    return size_ == 0;
+  }
+  size_type
+  size() const noexcept
+  {
+    return size_;
+  }
+
+  // Iteration is in insertion order.
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+  const_iterator
+  cbegin() const noexcept
+  {
+    return begin();
+  }
+  const_iterator
+  cend() const noexcept
+  {
+    return end();
+  }
+
+  // Make room for n entries in total, so that inserting them causes no
+  // further allocation.
+  void reserve(size_type n);
+
+  // The entry with the given key, or end().
+  template <class Key>
+  const_iterator find(Key const& key) const;
+
+  // Insert an entry constructed from key and args, unless one with the
+  // same key is present; returns the entry with the key, and whether it
+  // was inserted.
+  template <class... Args>
+  std::pair<const_iterator, bool> emplace(K const& key, Args&&... args);
+
+  // The entries, sorted by key.
+  std::vector<std::reference_wrapper<value_type const>> sorted() const;
+
+private:
+  // The position of an entry: its chunk, and its offset in the chunk
+  // (so at most 2^32 - 1 entries).  Unused slots have chunk == no_chunk.
+  struct slot {
+    std::size_t hash;
+    std::uint32_t chunk;
+    std::uint32_t offset;
+  };
+  static constexpr std::uint32_t no_chunk{
+    std::numeric_limits<std::uint32_t>::max()};
+
+  static constexpr size_type min_slots{16};
+  static constexpr size_type min_chunk{16};
+
+  // At most three quarters of the slots are used.
+  static constexpr size_type
+  max_entries(size_type const nslots) noexcept
+  {
+    return nslots / 4 * 3;
+  }
+
+  size_type
+  first_slot(std::size_t const hash) const noexcept
+  {
+    // Mix the bits, since std::hash is the identity for integers.
+    auto const h = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_type>(h ^ (h >> 32)) & (slots_.size() - 1);
+  }
+
+  value_type const&
+  entry(slot const& s) const noexcept
+  {
+    return chunks_[s.chunk][s.offset];
+  }
+  const_iterator
+  iterator_to(slot const& s) const noexcept
+  {
+    return const_iterator{chunks_, s.chunk, s.offset};
+  }
+
+  void rehash(size_type nslots);
+  template <class... Args>
+  slot store(std::size_t hash, K const& key, Args&&... args);
+
+  std::vector<slot> slots_{};
+  std::vector<std::vector<value_type>> chunks_{};
+  size_type size_{0};
+  Hash hash_{};
+  KeyEqual equal_{};
+
+}; // open_addressing_map<>
+
+// ======================================================================
+
+template <class K, class V, class Hash, class KeyEqual>
+class cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::const_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename open_addressing_map::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = value_type const*;
+  using reference = value_type const&;
+
+  const_iterator() = default;
+
+  reference
+  operator*() const noexcept
+  {
+    return (*chunks_)[chunk_][offset_];
+  }
+  pointer
+  operator->() const noexcept
+  {
+    return &**this;
+  }
+
+  const_iterator&
+  operator++() noexcept
+  {
+    ++offset_;
+    skip_chunk_ends();
+    return *this;
+  }
+  const_iterator
+  operator++(int) noexcept
+  {
+    auto result = *this;
+    ++*this;
+    return result;
+  }
+
+  friend bool
+  operator==(const_iterator const& a, const_iterator const& b) noexcept
+  {
+    return a.chunk_ == b.chunk_ && a.offset_ == b.offset_;
+  }
+  friend bool
+  operator!=(const_iterator const& a, const_iterator const& b) noexcept
+  {
+    return !(a == b);
+  }
+
+private:
+  friend class open_addressing_map;
+  using chunks_t = std::vector<std::vector<value_type>>;
+
+  const_iterator(chunks_t const& chunks,
+                 std::size_t const chunk,
+                 std::size_t const offset) noexcept
+    : chunks_{&chunks}, chunk_{chunk}, offset_{offset}
+  {
+    skip_chunk_ends();
+  }
+
+  void
+  skip_chunk_ends() noexcept
+  {
+    while (chunk_ != chunks_->size() && offset_ == (*chunks_)[chunk_].size()) {
+      ++chunk_;
+      offset_ = 0;
+    }
+  }
+
+  chunks_t const* chunks_{nullptr};
+  std::size_t chunk_{0};
+  std::size_t offset_{0};
+};
+
+// ======================================================================
+
+template <class K, class V, class Hash, class KeyEqual>
+typename cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::const_iterator
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::begin() const noexcept
+{
+  return const_iterator{chunks_, 0, 0};
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+typename cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::const_iterator
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::end() const noexcept
+{
+  return const_iterator{chunks_, chunks_.size(), 0};
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::reserve(
+  size_type const n)
+{
+  if (n <= size_) {
+    return;
+  }
+  if (max_entries(slots_.size()) < n) {
+    auto nslots = std::max(slots_.size(), min_slots);
+    while (max_entries(nslots) < n) {
+      nslots *= 2;
+    }
+    rehash(nslots);
+  }
+  auto const room =
+    chunks_.empty() ? 0 : chunks_.back().capacity() - chunks_.back().size();
+  if (room < n - size_) {
+    chunks_.emplace_back().reserve(n - size_);
+  }
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Key>
+typename cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::const_iterator
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::find(
+  Key const& key) const
+{
+  if (size_ == 0) {
+    return end();
+  }
+  std::size_t const hash = hash_(key);
+  auto const mask = slots_.size() - 1;
+  for (auto i = first_slot(hash);; i = (i + 1) & mask) {
+    auto const& s = slots_[i];
+    if (s.chunk == no_chunk) {
+      return end();
+    }
+    if (s.hash == hash && equal_(entry(s).first, key)) {
+      return iterator_to(s);
+    }
+  }
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class... Args>
+std::pair<
+  typename cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::
+    const_iterator,
+  bool>
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::emplace(
+  K const& key,
+  Args&&... args)
+{
+  if (max_entries(slots_.size()) == size_) {
+    rehash(std::max(2 * slots_.size(), min_slots));
+  }
+  std::size_t const hash = hash_(key);
+  auto const mask = slots_.size() - 1;
+  auto i = first_slot(hash);
+  for (; slots_[i].chunk != no_chunk; i = (i + 1) & mask) {
+    auto const& s = slots_[i];
+    if (s.hash == hash && equal_(entry(s).first, key)) {
+      return {iterator_to(s), false};
+    }
+  }
+  slots_[i] = store(hash, key, std::forward<Args>(args)...);
+  ++size_;
+  return {iterator_to(slots_[i]), true};
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+std::vector<std::reference_wrapper<
+  typename cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::value_type
+    const>>
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::sorted() const
+{
+  std::vector<std::reference_wrapper<value_type const>> result(begin(),
+                                                               end());
+  std::sort(result.begin(),
+            result.end(),
+            [](value_type const& a, value_type const& b) {
+              return a.first < b.first;
+            });
+  return result;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::rehash(
+  size_type const nslots)
+{
+  std::vector<slot> slots(nslots, slot{0, no_chunk, 0});
+  slots_.swap(slots);
+  auto const mask = nslots - 1;
+  for (auto const& s : slots) {
+    if (s.chunk != no_chunk) {
+      auto i = first_slot(s.hash);
+      while (slots_[i].chunk != no_chunk) {
+        i = (i + 1) & mask;
+      }
+      slots_[i] = s;
+    }
+  }
+}
+
+// Construct an entry at the end of the last chunk, starting a new chunk
+// (never reallocating an old one) if it is full, and return its slot.
+template <class K, class V, class Hash, class KeyEqual>
+template <class... Args>
+typename cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::slot
+cet::detail::open_addressing_map<K, V, Hash, KeyEqual>::store(
+  std::size_t const hash,
+  K const& key,
+  Args&&... args)
+{
+  if (chunks_.empty() || chunks_.back().size() == chunks_.back().capacity()) {
+    chunks_.emplace_back().reserve(std::max(size_, min_chunk));
+  }
+  auto& chunk = chunks_.back();
+  chunk.emplace_back(std::piecewise_construct,
+                     std::forward_as_tuple(key),
+                     std::forward_as_tuple(std::forward<Args>(args)...));
+  return {hash,
+          static_cast<std::uint32_t>(chunks_.size() - 1),
+          static_cast<std::uint32_t>(chunk.size() - 1)};
+}
+
+#endif /* cetlib_detail_open_addressing_map_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,275 @@
+#ifndef cetlib_detail_xxh3_h
+#define cetlib_detail_xxh3_h
+////////////////////////////////////////////////////////////////////////
+// xxh3
+//
+// constexpr building blocks of the 64-bit XXH3 hash (xxHash 0.8), used
+// by cet::fast_hash64: the default secret, and the complete algorithm
+// for inputs of up to 240 bytes. Longer inputs are handled by
+// xxh3_long() (fast_hash64.cc), which has vectorized implementations.
+//
+// Bytes are read individually and assembled in little-endian order, so
+// the functions can be evaluated at compile time and give the same
+// result on any host; compilers turn the assembly into single loads.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cet::detail::xxh3 {
+  using u32 = std::uint32_t;
+  using u64 = std::uint64_t;
+
+  constexpr u32 prime32_1{0x9E3779B1U};
+  constexpr u32 prime32_2{0x85EBCA77U};
+  constexpr u32 prime32_3{0xC2B2AE3DU};
+  constexpr u64 prime64_1{0x9E3779B185EBCA87ULL};
+  constexpr u64 prime64_2{0xC2B2AE3D27D4EB4FULL};
+  constexpr u64 prime64_3{0x165667B19E3779F9ULL};
+  constexpr u64 prime64_4{0x85EBCA77C2B2AE63ULL};
+  constexpr u64 prime64_5{0x27D4EB2F165667C5ULL};
+  constexpr u64 prime_mx1{0x165667919E3779F9ULL};
+  constexpr u64 prime_mx2{0x9FB21C651E98DF25ULL};
+
+  constexpr std::size_t secret_size{192};
+  constexpr std::size_t midsize_max{240};
+
+  inline constexpr unsigned char default_secret[secret_size]{
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c,
+    0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+    0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e,
+    0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6,
+    0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+    0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97,
+    0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7,
+    0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+    0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83,
+    0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26,
+    0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+    0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f,
+    0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e};
+
+  // Little-endian loads.
+  template <typename Byte>
+  constexpr u32
+  read32(Byte const* const p)
+  {
+    return u32{static_cast<unsigned char>(p[0])} |
+           u32{static_cast<unsigned char>(p[1])} << 8 |
+           u32{static_cast<unsigned char>(p[2])} << 16 |
+           u32{static_cast<unsigned char>(p[3])} << 24;
+  }
+
+  template <typename Byte>
+  constexpr u64
+  read64(Byte const* const p)
+  {
+    return u64{read32(p)} | u64{read32(p + 4)} << 32;
+  }
+
+  constexpr u64
+  rotl64(u64 const x, int const r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  constexpr u32
+  swap32(u32 const x)
+  {
+    return ((x << 24) & 0xff000000U) | ((x << 8) & 0x00ff0000U) |
+           ((x >> 8) & 0x0000ff00U) | ((x >> 24) & 0x000000ffU);
+  }
+
+  constexpr u64
+  swap64(u64 const x)
+  {
+    return u64{swap32(static_cast<u32>(x))} << 32 |
+           swap32(static_cast<u32>(x >> 32));
+  }
+
+  // The 128-bit product of a and b, folded to 64 bits.
+  constexpr u64
+  mul128_fold64(u64 const a, u64 const b)
+  {
+#ifdef __SIZEOF_INT128__
+    __extension__ using u128 = unsigned __int128;
+    u128 const product = u128{a} * b;
+    return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#else
+    u64 const lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    u64 const hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+    u64 const lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+    u64 const hi_hi = (a >> 32) * (b >> 32);
+    u64 const cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    u64 const upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    u64 const lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    return lower ^ upper;
+#endif
+  }
+
+  constexpr u64
+  xxh64_avalanche(u64 h)
+  {
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    return h ^ (h >> 32);
+  }
+
+  constexpr u64
+  avalanche(u64 h)
+  {
+    h ^= h >> 37;
+    h *= prime_mx1;
+    return h ^ (h >> 32);
+  }
+
+  constexpr u64
+  rrmxmx(u64 h, u64 const len)
+  {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= prime_mx2;
+    h ^= (h >> 35) + len;
+    h *= prime_mx2;
+    return h ^ (h >> 28);
+  }
+
+  template <typename Byte>
+  constexpr u64
+  mix16B(Byte const* const input,
+         unsigned char const* const secret,
+         u64 const seed)
+  {
+    return mul128_fold64(read64(input) ^ (read64(secret) + seed),
+                         read64(input + 8) ^ (read64(secret + 8) - seed));
+  }
+
+  template <typename Byte>
+  constexpr u64
+  len_1to3(Byte const* const input, std::size_t const len, u64 const seed)
+  {
+    auto const c1 = static_cast<unsigned char>(input[0]);
+    auto const c2 = static_cast<unsigned char>(input[len >> 1]);
+    auto const c3 = static_cast<unsigned char>(input[len - 1]);
+    u32 const combined = u32{c1} << 16 | u32{c2} << 24 | u32{c3} << 0 |
+                         static_cast<u32>(len) << 8;
+    u64 const bitflip =
+      (read32(default_secret) ^ read32(default_secret + 4)) + seed;
+    return xxh64_avalanche(u64{combined} ^ bitflip);
+  }
+
+  template <typename Byte>
+  constexpr u64
+  len_4to8(Byte const* const input, std::size_t const len, u64 seed)
+  {
+    seed ^= u64{swap32(static_cast<u32>(seed))} << 32;
+    u32 const input1 = read32(input);
+    u32 const input2 = read32(input + len - 4);
+    u64 const bitflip =
+      (read64(default_secret + 8) ^ read64(default_secret + 16)) - seed;
+    u64 const input64 = input2 + (u64{input1} << 32);
+    return rrmxmx(input64 ^ bitflip, len);
+  }
+
+  template <typename Byte>
+  constexpr u64
+  len_9to16(Byte const* const input, std::size_t const len, u64 const seed)
+  {
+    u64 const bitflip1 =
+      (read64(default_secret + 24) ^ read64(default_secret + 32)) + seed;
+    u64 const bitflip2 =
+      (read64(default_secret + 40) ^ read64(default_secret + 48)) - seed;
+    u64 const input_lo = read64(input) ^ bitflip1;
+    u64 const input_hi = read64(input + len - 8) ^ bitflip2;
+    u64 const acc = len + swap64(input_lo) + input_hi +
+                    mul128_fold64(input_lo, input_hi);
+    return avalanche(acc);
+  }
+
+  template <typename Byte>
+  constexpr u64
+  len_0to16(Byte const* const input, std::size_t const len, u64 const seed)
+  {
+    if (len > 8) {
+      return len_9to16(input, len, seed);
+    }
+    if (len >= 4) {
+      return len_4to8(input, len, seed);
+    }
+    if (len > 0) {
+      return len_1to3(input, len, seed);
+    }
+    return xxh64_avalanche(seed ^ (read64(default_secret + 56) ^
+                                   read64(default_secret + 64)));
+  }
+
+  template <typename Byte>
+  constexpr u64
+  len_17to128(Byte const* const input, std::size_t const len, u64 const seed)
+  {
+    auto const* const s = default_secret;
+    u64 acc = len * prime64_1;
+    if (len > 32) {
+      if (len > 64) {
+        if (len > 96) {
+          acc += mix16B(input + 48, s + 96, seed);
+          acc += mix16B(input + len - 64, s + 112, seed);
+        }
+        acc += mix16B(input + 32, s + 64, seed);
+        acc += mix16B(input + len - 48, s + 80, seed);
+      }
+      acc += mix16B(input + 16, s + 32, seed);
+      acc += mix16B(input + len - 32, s + 48, seed);
+    }
+    acc += mix16B(input, s, seed);
+    acc += mix16B(input + len - 16, s + 16, seed);
+    return avalanche(acc);
+  }
+
+  template <typename Byte>
+  constexpr u64
+  len_129to240(Byte const* const input,
+               std::size_t const len,
+               u64 const seed)
+  {
+    auto const* const s = default_secret;
+    u64 acc = len * prime64_1;
+    std::size_t const rounds = len / 16;
+    for (std::size_t i = 0; i != 8; ++i) {
+      acc += mix16B(input + 16 * i, s + 16 * i, seed);
+    }
+    acc = avalanche(acc);
+    for (std::size_t i = 8; i < rounds; ++i) {
+      acc += mix16B(input + 16 * i, s + 16 * (i - 8) + 3, seed);
+    }
+    acc += mix16B(input + len - 16, s + 136 - 17, seed);
+    return avalanche(acc);
+  }
+
+  // The hash of an input of at most midsize_max bytes.
+  template <typename Byte>
+  constexpr u64
+  hash_short(Byte const* const input, std::size_t const len, u64 const seed)
+  {
+    if (len <= 16) {
+      return len_0to16(input, len, seed);
+    }
+    if (len <= 128) {
+      return len_17to128(input, len, seed);
+    }
+    return len_129to240(input, len, seed);
+  }
+
+  // The hash of an input of more than midsize_max bytes.
+  u64 hash_long(void const* input, std::size_t len, u64 seed);
+}
+
+#endif /* cetlib_detail_xxh3_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,226 @@
+// ======================================================================
+//
+// evp_digest: Message digests via OpenSSL's EVP interface
+//
+// ======================================================================
+
+#include "cetlib/evp_digest.h"
+
+#include "cetlib_except/exception.h"
+
+#ifdef __APPLE__
+#define COMMON_DIGEST_FOR_OPENSSL
+#include <CommonCrypto/CommonDigest.h>
+#undef COMMON_DIGEST_FOR_OPENSSL
+#else
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+#endif
+
+#include <new>
+#include <utility>
+
+using cet::digest_algorithm;
+
+namespace {
+  char const*
+  name_of(digest_algorithm const algorithm)
+  {
+    switch (algorithm) {
+    case digest_algorithm::sha1:
+      return "SHA1";
+    case digest_algorithm::sha256:
+      return "SHA256";
+    case digest_algorithm::blake2b512:
+      return "BLAKE2b512";
+    case digest_algorithm::blake2s256:
+      return "BLAKE2s256";
+    }
+    return "unknown";
+  }
+}
+
+#ifdef __APPLE__
+
+// ----------------------------------------------------------------------
+// CommonCrypto provides SHA-1 and SHA-256 only.
+
+struct cet::detail::evp_context::state {
+  digest_algorithm algorithm;
+  union {
+    SHA_CTX sha1;
+    SHA256_CTX sha256;
+  };
+};
+
+bool
+cet::digest_available(digest_algorithm const algorithm)
+{
+  return algorithm == digest_algorithm::sha1 ||
+         algorithm == digest_algorithm::sha256;
+}
+
+void
+cet::detail::evp_context::reset()
+{
+  if (state_->algorithm == digest_algorithm::sha1) {
+    SHA1_Init(&state_->sha1);
+  } else {
+    SHA256_Init(&state_->sha256);
+  }
+}
+
+void
+cet::detail::evp_context::update(void const* const data,
+                                 std::size_t const size)
+{
+  if (state_->algorithm == digest_algorithm::sha1) {
+    SHA1_Update(&state_->sha1, data, size);
+  } else {
+    SHA256_Update(&state_->sha256, data, size);
+  }
+}
+
+void
+cet::detail::evp_context::final(unsigned char* const out)
+{
+  if (state_->algorithm == digest_algorithm::sha1) {
+    SHA1_Final(out, &state_->sha1);
+  } else {
+    SHA256_Final(out, &state_->sha256);
+  }
+  reset();
+}
+
+#else
+
+// ----------------------------------------------------------------------
+// OpenSSL
+
+namespace {
+  // The message-digest implementation for the algorithm, or nullptr if
+  // it is unavailable. With OpenSSL 3, fetching explicitly once avoids
+  // an implicit fetch for every (re)initialization.
+  EVP_MD const*
+  md_for(digest_algorithm const algorithm)
+  {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    auto const fetch = [](digest_algorithm const a) -> EVP_MD const* {
+      return EVP_MD_fetch(nullptr, name_of(a), nullptr);
+    };
+    static EVP_MD const* const mds[] = {fetch(digest_algorithm::sha1),
+                                        fetch(digest_algorithm::sha256),
+                                        fetch(digest_algorithm::blake2b512),
+                                        fetch(digest_algorithm::blake2s256)};
+    return mds[static_cast<int>(algorithm)];
+#else
+    switch (algorithm) {
+    case digest_algorithm::sha1:
+      return EVP_sha1();
+    case digest_algorithm::sha256:
+      return EVP_sha256();
+#ifndef OPENSSL_NO_BLAKE2
+    case digest_algorithm::blake2b512:
+      return EVP_blake2b512();
+    case digest_algorithm::blake2s256:
+      return EVP_blake2s256();
+#endif
+    default:
+      return nullptr;
+    }
+#endif
+  }
+
+  void
+  check(int const status, char const* const what)
+  {
+    if (status != 1) {
+      throw cet::exception("evp_digest") << what << " failed.\n";
+    }
+  }
+}
+
+struct cet::detail::evp_context::state {
+  using context_ptr = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>;
+
+  EVP_MD const* md;
+  context_ptr ctx;
+};
+
+bool
+cet::digest_available(digest_algorithm const algorithm)
+{
+  return md_for(algorithm) != nullptr;
+}
+
+void
+cet::detail::evp_context::reset()
+{
+  check(EVP_DigestInit_ex(state_->ctx.get(), state_->md, nullptr),
+        "EVP_DigestInit_ex");
+}
+
+void
+cet::detail::evp_context::update(void const* const data,
+                                 std::size_t const size)
+{
+  check(EVP_DigestUpdate(state_->ctx.get(), data, size), "EVP_DigestUpdate");
+}
+
+void
+cet::detail::evp_context::final(unsigned char* const out)
+{
+  check(EVP_DigestFinal_ex(state_->ctx.get(), out, nullptr),
+        "EVP_DigestFinal_ex");
+  reset();
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+
+cet::detail::evp_context::evp_context(digest_algorithm const algorithm)
+{
+  if (!digest_available(algorithm)) {
+    throw cet::exception("evp_digest")
+      << "Digest algorithm " << name_of(algorithm)
+      << " is not available from the crypto library.\n";
+  }
+#ifdef __APPLE__
+  state_.reset(new state);
+  state_->algorithm = algorithm;
+#else
+  state::context_ptr ctx{EVP_MD_CTX_new(), &EVP_MD_CTX_free};
+  if (ctx == nullptr) {
+    throw std::bad_alloc{};
+  }
+  state_.reset(new state{md_for(algorithm), std::move(ctx)});
+#endif
+  reset();
+}
+
+cet::detail::evp_context::~evp_context() noexcept = default;
+
+cet::detail::evp_context::evp_context(evp_context&&) noexcept = default;
+
+cet::detail::evp_context&
+cet::detail::evp_context::operator=(evp_context&& other) noexcept
+{
+  evp_context{std::move(other)}.state_.swap(state_);
+  return *this;
+}
+
+char*
+cet::to_hex(unsigned char const* const data,
+            std::size_t const size,
+            char* out)
+{
+  constexpr char hex_chars[] = "0123456789abcdef";
+  for (auto p = data, end = data + size; p != end; ++p) {
+    *out++ = hex_chars[*p >> 4];
+    *out++ = hex_chars[*p & 0x0F];
+  }
+  return out;
+}
+
+// ======================================================================
@@ -0,0 +1,182 @@
+#ifndef cetlib_evp_digest_h
+#define cetlib_evp_digest_h
+
+// ======================================================================
+//
+// evp_digest: Message digests via OpenSSL's EVP interface
+//
+// The EVP interface selects the fastest implementation of each
+// algorithm for the host (e.g. the SHA extensions or AVX2 on x86-64,
+// the ARMv8 crypto extensions). Use digest_available() to test for
+// algorithms, such as the BLAKE2 family, that the crypto library may
+// have been built without; constructing an evp_digest for an
+// unavailable algorithm throws cet::exception.
+//
+// digest() returns the digest of the data seen so far and resets the
+// object for reuse. hexdigest() renders it as lowercase hex into a
+// std::array or caller-provided buffer, without allocating.
+//
+//   cet::sha256_digest h;
+//   h << "some text";
+//   auto const hex = h.hexdigest(); // std::array<char, 64>
+//
+// ======================================================================
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace cet {
+  enum class digest_algorithm { sha1, sha256, blake2b512, blake2s256 };
+
+  constexpr std::size_t
+  digest_size(digest_algorithm const algorithm)
+  {
+    switch (algorithm) {
+    case digest_algorithm::sha1:
+      return 20;
+    case digest_algorithm::sha256:
+    case digest_algorithm::blake2s256:
+      return 32;
+    case digest_algorithm::blake2b512:
+      return 64;
+    }
+    return 0;
+  }
+
+  bool digest_available(digest_algorithm algorithm);
+
+  template <digest_algorithm A>
+  class evp_digest;
+
+  using sha1_digest = evp_digest<digest_algorithm::sha1>;
+  using sha256_digest = evp_digest<digest_algorithm::sha256>;
+  using blake2b512_digest = evp_digest<digest_algorithm::blake2b512>;
+  using blake2s256_digest = evp_digest<digest_algorithm::blake2s256>;
+
+  // Write 2 * size lowercase hex characters (without a terminating
+  // null) to out; return the end of the output.
+  char* to_hex(unsigned char const* data, std::size_t size, char* out);
+
+  template <std::size_t N>
+  std::array<char, 2 * N> to_hex(std::array<unsigned char, N> const& data);
+  template <std::size_t N>
+  std::array<char, 2 * N> to_hex(unsigned char const (&data)[N]);
+
+  namespace detail {
+    class evp_context {
+    public:
+      explicit evp_context(digest_algorithm algorithm);
+      ~evp_context() noexcept;
+      evp_context(evp_context&&) noexcept;
+      evp_context& operator=(evp_context&&) noexcept;
+
+      void reset();
+      void update(void const* data, std::size_t size);
+      // Write the digest to out, then reset.
+      void final(unsigned char* out);
+
+    private:
+      struct state;
+      std::unique_ptr<state> state_;
+    };
+  }
+}
+
+// ======================================================================
+
+template <cet::digest_algorithm A>
+class cet::evp_digest {
+public:
+  static constexpr digest_algorithm algorithm{A};
+  static constexpr std::size_t digest_sz{digest_size(A)};
+  using uchar = unsigned char;
+  using digest_t = std::array<uchar, digest_sz>;
+  using hexdigest_t = std::array<char, 2 * digest_sz>;
+
+  evp_digest() : context_{A} {}
+  explicit evp_digest(std::string_view const mesg) : evp_digest{}
+  {
+    operator<<(mesg);
+  }
+  evp_digest(void const* const data, std::size_t const size) : evp_digest{}
+  {
+    update(data, size);
+  }
+
+  void
+  reset()
+  {
+    context_.reset();
+  }
+
+  evp_digest&
+  operator<<(std::string_view const mesg)
+  {
+    return update(mesg.data(), mesg.size());
+  }
+  evp_digest&
+  operator<<(char const mesg)
+  {
+    return update(&mesg, 1u);
+  }
+  evp_digest&
+  update(void const* const data, std::size_t const size)
+  {
+    context_.update(data, size);
+    return *this;
+  }
+
+  digest_t
+  digest()
+  {
+    digest_t result;
+    context_.final(result.data());
+    return result;
+  }
+
+  hexdigest_t
+  hexdigest()
+  {
+    return to_hex(digest());
+  }
+
+  // Write 2 * digest_sz characters to out.
+  void
+  hexdigest(char* const out)
+  {
+    auto const d = digest();
+    to_hex(d.data(), d.size(), out);
+  }
+
+private:
+  detail::evp_context context_;
+
+}; // evp_digest
+
+// ======================================================================
+
+template <std::size_t N>
+std::array<char, 2 * N>
+cet::to_hex(std::array<unsigned char, N> const& data)
+{
+  std::array<char, 2 * N> result;
+  to_hex(data.data(), N, result.data());
+  return result;
+}
+
+template <std::size_t N>
+std::array<char, 2 * N>
+cet::to_hex(unsigned char const (&data)[N])
+{
+  std::array<char, 2 * N> result;
+  to_hex(data, N, result.data());
+  return result;
+}
+
+#endif /* cetlib_evp_digest_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,396 @@
+// ======================================================================
+//
+// fast_hash64: Fast, non-cryptographic 64-bit hash of a byte sequence
+//
+// Inputs longer than 240 bytes are processed in 64-byte stripes by
+// eight 64-bit accumulators, scrambled after each 1 KiB block. The
+// stripe accumulation and scrambling have scalar, SSE2 and AVX2
+// implementations, selected once according to the host processor; all
+// give identical results.
+//
+// ======================================================================
+
+#include "cetlib/fast_hash64.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CET_XXH3_X86
+#include <immintrin.h>
+#endif
+
+using namespace cet::detail::xxh3;
+
+namespace {
+  constexpr std::size_t stripe_len{64};
+  constexpr std::size_t stripes_per_block{(secret_size - stripe_len) / 8};
+  constexpr std::size_t block_len{stripe_len * stripes_per_block};
+  constexpr std::size_t last_stripe_secret_offset{secret_size -
+                                                  stripe_len - 7};
+  constexpr std::size_t merge_secret_offset{11};
+
+  // Accumulate nstripes stripes from input, using the secret starting
+  // at secret (which advances by 8 bytes per stripe).
+  using accumulate_t = void (*)(u64* acc,
+                                unsigned char const* input,
+                                unsigned char const* secret,
+                                std::size_t nstripes);
+  // Scramble the accumulators with the last 64 bytes of the secret.
+  using scramble_t = void (*)(u64* acc, unsigned char const* secret);
+
+#ifndef CET_XXH3_X86
+  void
+  accumulate_scalar(u64* const acc,
+                    unsigned char const* input,
+                    unsigned char const* secret,
+                    std::size_t const nstripes)
+  {
+    for (std::size_t n = 0; n != nstripes;
+         ++n, input += stripe_len, secret += 8) {
+      for (std::size_t i = 0; i != 8; ++i) {
+        u64 const data_val = read64(input + 8 * i);
+        u64 const data_key = data_val ^ read64(secret + 8 * i);
+        acc[i ^ 1] += data_val;
+        acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+      }
+    }
+  }
+
+  void
+  scramble_scalar(u64* const acc, unsigned char const* const secret)
+  {
+    for (std::size_t i = 0; i != 8; ++i) {
+      u64 a = acc[i];
+      a ^= a >> 47;
+      a ^= read64(secret + 8 * i);
+      acc[i] = a * prime32_1;
+    }
+  }
+#else
+  // SSE2 is part of the x86-64 baseline.
+  void
+  accumulate_sse2(u64* const acc,
+                  unsigned char const* input,
+                  unsigned char const* secret,
+                  std::size_t const nstripes)
+  {
+    auto* const xacc = reinterpret_cast<__m128i*>(acc);
+    for (std::size_t n = 0; n != nstripes;
+         ++n, input += stripe_len, secret += 8) {
+      for (std::size_t i = 0; i != 4; ++i) {
+        __m128i const data =
+          _mm_loadu_si128(reinterpret_cast<__m128i const*>(input) + i);
+        __m128i const key =
+          _mm_loadu_si128(reinterpret_cast<__m128i const*>(secret) + i);
+        __m128i const data_key = _mm_xor_si128(data, key);
+        __m128i const data_key_hi =
+          _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+        __m128i const product = _mm_mul_epu32(data_key, data_key_hi);
+        __m128i const swapped =
+          _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        xacc[i] = _mm_add_epi64(product, _mm_add_epi64(xacc[i], swapped));
+      }
+    }
+  }
+
+  void
+  scramble_sse2(u64* const acc, unsigned char const* const secret)
+  {
+    auto* const xacc = reinterpret_cast<__m128i*>(acc);
+    __m128i const prime = _mm_set1_epi32(static_cast<int>(prime32_1));
+    for (std::size_t i = 0; i != 4; ++i) {
+      __m128i a = xacc[i];
+      a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+      a = _mm_xor_si128(
+        a, _mm_loadu_si128(reinterpret_cast<__m128i const*>(secret) + i));
+      __m128i const a_hi = _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1));
+      __m128i const product_lo = _mm_mul_epu32(a, prime);
+      __m128i const product_hi = _mm_mul_epu32(a_hi, prime);
+      xacc[i] = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+    }
+  }
+
+#define CET_XXH3_AVX2 __attribute__((target("avx2")))
+
+  CET_XXH3_AVX2 inline __m256i
+  step(__m256i const acc, __m256i const data, __m256i const key)
+  {
+    __m256i const data_key = _mm256_xor_si256(data, key);
+    __m256i const data_key_hi =
+      _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+    __m256i const product = _mm256_mul_epu32(data_key, data_key_hi);
+    __m256i const swapped =
+      _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm256_add_epi64(product, _mm256_add_epi64(acc, swapped));
+  }
+
+  CET_XXH3_AVX2 void
+  accumulate_avx2(u64* const acc,
+                  unsigned char const* input,
+                  unsigned char const* secret,
+                  std::size_t const nstripes)
+  {
+    auto* const yacc = reinterpret_cast<__m256i*>(acc);
+    __m256i acc0 = _mm256_load_si256(yacc);
+    __m256i acc1 = _mm256_load_si256(yacc + 1);
+    for (std::size_t n = 0; n != nstripes;
+         ++n, input += stripe_len, secret += 8) {
+      auto const* const in = reinterpret_cast<__m256i const*>(input);
+      auto const* const sec = reinterpret_cast<__m256i const*>(secret);
+      acc0 = step(acc0, _mm256_loadu_si256(in), _mm256_loadu_si256(sec));
+      acc1 = step(
+        acc1, _mm256_loadu_si256(in + 1), _mm256_loadu_si256(sec + 1));
+    }
+    _mm256_store_si256(yacc, acc0);
+    _mm256_store_si256(yacc + 1, acc1);
+  }
+
+  CET_XXH3_AVX2 void
+  scramble_avx2(u64* const acc, unsigned char const* const secret)
+  {
+    auto* const yacc = reinterpret_cast<__m256i*>(acc);
+    __m256i const prime = _mm256_set1_epi32(static_cast<int>(prime32_1));
+    for (std::size_t i = 0; i != 2; ++i) {
+      __m256i a = _mm256_load_si256(yacc + i);
+      a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+      a = _mm256_xor_si256(
+        a, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(secret) + i));
+      __m256i const a_hi = _mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1));
+      __m256i const product_lo = _mm256_mul_epu32(a, prime);
+      __m256i const product_hi = _mm256_mul_epu32(a_hi, prime);
+      _mm256_store_si256(
+        yacc + i,
+        _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32)));
+    }
+  }
+
+#undef CET_XXH3_AVX2
+#endif
+
+  struct implementation {
+    accumulate_t accumulate;
+    scramble_t scramble;
+  };
+
+  implementation
+  select_implementation()
+  {
+#ifdef CET_XXH3_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return {accumulate_avx2, scramble_avx2};
+    }
+    return {accumulate_sse2, scramble_sse2};
+#else
+    return {accumulate_scalar, scramble_scalar};
+#endif
+  }
+
+  implementation const&
+  impl()
+  {
+    static implementation const result{select_implementation()};
+    return result;
+  }
+
+  // The accumulators' initial values.
+  constexpr u64 initial_acc[8]{prime32_3,
+                               prime64_1,
+                               prime64_2,
+                               prime64_3,
+                               prime64_4,
+                               prime32_2,
+                               prime64_5,
+                               prime32_1};
+
+  // The secret used for long inputs with a nonzero seed.
+  void
+  init_custom_secret(unsigned char* const secret, u64 const seed)
+  {
+    for (std::size_t i = 0; i != secret_size / 16; ++i) {
+      u64 const lo = read64(default_secret + 16 * i) + seed;
+      u64 const hi = read64(default_secret + 16 * i + 8) - seed;
+      for (std::size_t b = 0; b != 8; ++b) {
+        secret[16 * i + b] = static_cast<unsigned char>(lo >> (8 * b));
+        secret[16 * i + 8 + b] = static_cast<unsigned char>(hi >> (8 * b));
+      }
+    }
+  }
+
+  u64
+  merge_accs(u64 const* const acc,
+             unsigned char const* const secret,
+             u64 const start)
+  {
+    u64 result = start;
+    for (std::size_t i = 0; i != 4; ++i) {
+      result += mul128_fold64(acc[2 * i] ^ read64(secret + 16 * i),
+                              acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+  }
+}
+
+// ----------------------------------------------------------------------
+
+u64
+cet::detail::xxh3::hash_long(void const* const data,
+                             std::size_t const len,
+                             u64 const seed)
+{
+  auto const* const input = static_cast<unsigned char const*>(data);
+  alignas(64) unsigned char custom_secret[secret_size];
+  unsigned char const* secret = default_secret;
+  if (seed != 0) {
+    init_custom_secret(custom_secret, seed);
+    secret = custom_secret;
+  }
+
+  auto const& [accumulate, scramble] = impl();
+  alignas(64) u64 acc[8];
+  std::memcpy(acc, initial_acc, sizeof acc);
+
+  std::size_t const nblocks = (len - 1) / block_len;
+  for (std::size_t n = 0; n != nblocks; ++n) {
+    accumulate(acc, input + n * block_len, secret, stripes_per_block);
+    scramble(acc, secret + secret_size - stripe_len);
+  }
+
+  // The last, partial block, and the last stripe.
+  std::size_t const nstripes =
+    ((len - 1) - block_len * nblocks) / stripe_len;
+  accumulate(acc, input + nblocks * block_len, secret, nstripes);
+  accumulate(acc,
+             input + len - stripe_len,
+             secret + last_stripe_secret_offset,
+             1);
+
+  return merge_accs(acc, secret + merge_secret_offset, len * prime64_1);
+}
+
+// ----------------------------------------------------------------------
+
+cet::fast_hasher64::fast_hasher64(std::uint64_t const seed)
+{
+  reset(seed);
+}
+
+cet::fast_hasher64::fast_hasher64(void const* const data,
+                                  std::size_t const size)
+{
+  reset();
+  update(data, size);
+}
+
+void
+cet::fast_hasher64::reset(std::uint64_t const seed)
+{
+  std::memcpy(acc_, initial_acc, sizeof acc_);
+  if (seed == 0) {
+    std::memcpy(secret_, default_secret, secret_size);
+  } else {
+    init_custom_secret(secret_, seed);
+  }
+  seed_ = seed;
+  total_size_ = 0;
+  buffered_ = 0;
+  stripes_in_block_ = 0;
+}
+
+void
+cet::fast_hasher64::consume_stripes(unsigned char const* input,
+                                    std::size_t n)
+{
+  auto const& [accumulate, scramble] = impl();
+  while (n != 0) {
+    auto const count = std::min(n, stripes_per_block - stripes_in_block_);
+    accumulate(acc_, input, secret_ + 8 * stripes_in_block_, count);
+    input += count * stripe_len;
+    n -= count;
+    stripes_in_block_ += count;
+    if (stripes_in_block_ == stripes_per_block) {
+      scramble(acc_, secret_ + secret_size - stripe_len);
+      stripes_in_block_ = 0;
+    }
+  }
+}
+
+cet::fast_hasher64&
+cet::fast_hasher64::update(void const* const data, std::size_t const size)
+{
+  auto const* input = static_cast<unsigned char const*>(data);
+  auto const* const end = input + size;
+  total_size_ += size;
+
+  // Input is consumed only when more follows, so the buffer always
+  // holds the final 1 to 256 bytes for digest().
+  if (size <= buffer_size - buffered_) {
+    std::memcpy(buffer_ + buffered_, input, size);
+    buffered_ += size;
+    return *this;
+  }
+
+  if (buffered_ != 0) {
+    auto const fill = buffer_size - buffered_;
+    std::memcpy(buffer_ + buffered_, input, fill);
+    input += fill;
+    consume_stripes(buffer_, buffer_size / stripe_len);
+    buffered_ = 0;
+  }
+
+  if (static_cast<std::size_t>(end - input) > buffer_size) {
+    auto const n = (end - input - 1) / buffer_size;
+    consume_stripes(input, n * (buffer_size / stripe_len));
+    input += n * buffer_size;
+    // Keep the last consumed stripe, in case the final stripe must
+    // include some of it.
+    std::memcpy(
+      buffer_ + buffer_size - stripe_len, input - stripe_len, stripe_len);
+  }
+
+  std::memcpy(buffer_, input, end - input);
+  buffered_ = end - input;
+  return *this;
+}
+
+cet::fast_hasher64::digest_t
+cet::fast_hasher64::digest() const
+{
+  if (total_size_ <= midsize_max) {
+    return hash_short(buffer_, buffered_, seed_);
+  }
+
+  // Finish a copy of the state, so more data may be added later.
+  auto const& [accumulate, scramble] = impl();
+  alignas(64) u64 acc[8];
+  std::memcpy(acc, acc_, sizeof acc);
+  unsigned char last_stripe[stripe_len];
+  unsigned char const* last_stripe_ptr{};
+  if (buffered_ >= stripe_len) {
+    auto const nstripes = (buffered_ - 1) / stripe_len;
+    auto stripes_in_block = stripes_in_block_;
+    for (std::size_t n = 0; n != nstripes; ++n) {
+      accumulate(acc,
+                 buffer_ + n * stripe_len,
+                 secret_ + 8 * stripes_in_block,
+                 1);
+      if (++stripes_in_block == stripes_per_block) {
+        scramble(acc, secret_ + secret_size - stripe_len);
+        stripes_in_block = 0;
+      }
+    }
+    last_stripe_ptr = buffer_ + buffered_ - stripe_len;
+  } else {
+    // The final stripe starts in the previously-consumed data.
+    auto const catchup = stripe_len - buffered_;
+    std::memcpy(last_stripe, buffer_ + buffer_size - catchup, catchup);
+    std::memcpy(last_stripe + catchup, buffer_, buffered_);
+    last_stripe_ptr = last_stripe;
+  }
+  accumulate(acc, last_stripe_ptr, secret_ + last_stripe_secret_offset, 1);
+  return merge_accs(
+    acc, secret_ + merge_secret_offset, total_size_ * prime64_1);
+}
+
+// ======================================================================
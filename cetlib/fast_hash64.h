@@ -0,0 +1,103 @@
+#ifndef cetlib_fast_hash64_h
+#define cetlib_fast_hash64_h
+
+// ======================================================================
+//
+// fast_hash64: Fast, non-cryptographic 64-bit hash of a byte sequence
+//
+// The hash is XXH3-64 (xxHash 0.8), so values are stable across hosts
+// and releases and can be reproduced with other xxHash implementations
+// (e.g. "xxhsum -H3"). It is suitable for hash tables and in-memory
+// keys, but not where resistance to deliberate collisions is needed.
+//
+// One-shot:
+//
+//   constexpr auto h = cet::fast_hash64("label"); // Up to 240 bytes.
+//   auto const h2 = cet::fast_hash64(std::string_view{data, size}, seed);
+//
+// Streaming, for data arriving in pieces (same result as one-shot):
+//
+//   cet::fast_hasher64 hasher;
+//   hasher << "some" << ' ' << text;
+//   hasher.update(data, size);
+//   auto const h3 = hasher.digest();
+//
+// Inputs longer than 240 bytes are processed with AVX2 or SSE2 on
+// x86-64 processors that support them.
+//
+// ======================================================================
+
+#include "cetlib/detail/xxh3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace cet {
+  class fast_hasher64;
+
+  constexpr std::uint64_t fast_hash64(std::string_view mesg,
+                                      std::uint64_t seed = 0);
+}
+
+// ======================================================================
+
+class cet::fast_hasher64 {
+public:
+  using digest_t = std::uint64_t;
+
+  explicit fast_hasher64(std::uint64_t seed = 0);
+  fast_hasher64(void const* data, std::size_t size);
+
+  void reset(std::uint64_t seed = 0);
+
+  fast_hasher64& operator<<(std::string_view mesg);
+  fast_hasher64& operator<<(char mesg);
+  fast_hasher64& update(void const* data, std::size_t size);
+
+  // The hash of the data seen so far; more may be added afterwards.
+  digest_t digest() const;
+
+private:
+  static constexpr std::size_t buffer_size{256};
+  static constexpr std::size_t stripe_size{64};
+
+  void consume_stripes(unsigned char const* input, std::size_t n);
+
+  alignas(64) std::uint64_t acc_[8];
+  alignas(64) unsigned char buffer_[buffer_size];
+  alignas(64) unsigned char secret_[detail::xxh3::secret_size];
+  std::uint64_t seed_;
+  std::uint64_t total_size_;
+  std::size_t buffered_;
+  std::size_t stripes_in_block_;
+
+}; // fast_hasher64
+
+// ======================================================================
+
+constexpr std::uint64_t
+cet::fast_hash64(std::string_view const mesg, std::uint64_t const seed)
+{
+  return mesg.size() <= detail::xxh3::midsize_max ?
+           detail::xxh3::hash_short(mesg.data(), mesg.size(), seed) :
+           detail::xxh3::hash_long(mesg.data(), mesg.size(), seed);
+}
+
+inline cet::fast_hasher64&
+cet::fast_hasher64::operator<<(std::string_view const mesg)
+{
+  return update(mesg.data(), mesg.size());
+}
+
+inline cet::fast_hasher64&
+cet::fast_hasher64::operator<<(char const mesg)
+{
+  return update(&mesg, 1u);
+}
+
+#endif /* cetlib_fast_hash64_h */
+
+// Local Variables:
+// mode: c++
+// End:
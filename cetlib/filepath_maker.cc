@@ -28,6 +28,13 @@ filepath_maker::operator()(std::string const& filename)
   return filename;
 }
 
+bool
+filepath_maker::is_pure() const noexcept
+{
+  // A derived policy may keep state.
+  return false;
+}
+
 // ----------------------------------------------------------------------
 
 filepath_lookup::filepath_lookup(std::string paths) : paths{move(paths)} {}
@@ -38,6 +45,12 @@ filepath_lookup::operator()(std::string const& filename)
   return paths.find_file(filename);
 }
 
+bool
+filepath_lookup::is_pure() const noexcept
+{
+  return true;
+}
+
 // ----------------------------------------------------------------------
 
 filepath_lookup_nonabsolute::filepath_lookup_nonabsolute(std::string paths)
@@ -51,6 +64,12 @@ filepath_lookup_nonabsolute::operator()(std::string const& filename)
                                                paths.find_file(filename);
 }
 
+bool
+filepath_lookup_nonabsolute::is_pure() const noexcept
+{
+  return true;
+}
+
 // ----------------------------------------------------------------------
 
 filepath_lookup_after1::filepath_lookup_after1(std::string paths)
@@ -63,6 +82,12 @@ filepath_lookup_after1::operator()(std::string const& filename)
   return after1 ? paths.find_file(filename) : (after1 = true, filename);
 }
 
+bool
+filepath_lookup_after1::is_pure() const noexcept
+{
+  return after1;
+}
+
 void
 filepath_lookup_after1::reset()
 {
@@ -96,6 +121,12 @@ filepath_first_absolute_or_lookup_with_dot::operator()(
   return after_paths.find_file(filename);
 }
 
+bool
+filepath_first_absolute_or_lookup_with_dot::is_pure() const noexcept
+{
+  return !first;
+}
+
 void
 filepath_first_absolute_or_lookup_with_dot::reset()
 {
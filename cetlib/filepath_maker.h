@@ -22,6 +22,12 @@
 //   an absolute path, a path relative to '.', or a path that can be
 //   looked up; all subsequent files must be looked up.
 //
+// A policy is pure if, from now on, the result of each call depends
+// only on the filename (and the file system), not on the calls made
+// before it, so that the calls may be made in any order, or not at
+// all. Only then may includer resolve filenames ahead of its
+// expansion. is_pure() is false unless a derived policy says so.
+//
 // ======================================================================
 
 #include "cetlib/search_path.h"
@@ -42,6 +48,7 @@ namespace cet {
 class cet::filepath_maker {
 public:
   virtual std::string operator()(std::string const& filename);
+  virtual bool is_pure() const noexcept;
 
   virtual ~filepath_maker() noexcept = default;
 
@@ -54,6 +61,7 @@ public:
   filepath_lookup(std::string paths);
 
   std::string operator()(std::string const& filename) override;
+  bool is_pure() const noexcept override;
 
 private:
   cet::search_path paths;
@@ -67,6 +75,7 @@ public:
   filepath_lookup_nonabsolute(std::string paths);
 
   std::string operator()(std::string const& filename) override;
+  bool is_pure() const noexcept override;
 
 private:
   cet::search_path paths;
@@ -80,6 +89,7 @@ public:
   filepath_lookup_after1(std::string paths);
 
   std::string operator()(std::string const& filename) override;
+  bool is_pure() const noexcept override; // After the first file.
 
   void reset();
 
@@ -98,6 +108,7 @@ public:
   // variable, *not* its name.
   filepath_first_absolute_or_lookup_with_dot(std::string paths);
   std::string operator()(std::string const& filename) override;
+  bool is_pure() const noexcept override; // After the first file.
   void reset();
 
 private:
@@ -0,0 +1,167 @@
+// ======================================================================
+//
+// hash_file, hash_stream: Calculate the digest of the contents of a
+//                         file or stream without holding it in memory
+//
+// ======================================================================
+
+#include "cetlib/hash_file.h"
+
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using cet::detail::hash_sink;
+
+namespace {
+  std::size_t constexpr block_size{1u << 20};
+  std::size_t constexpr block_alignment{4096};
+
+  // Block sizes for hashing mapped files: small enough for each block
+  // to stay in cache while the hasher processes it.
+  std::size_t constexpr mapped_block_size{1u << 22};
+
+  struct free_deleter {
+    void
+    operator()(void* const p) const noexcept
+    {
+      std::free(p);
+    }
+  };
+
+  using block_ptr = std::unique_ptr<char, free_deleter>;
+
+  block_ptr
+  make_block()
+  {
+    block_ptr result{
+      static_cast<char*>(std::aligned_alloc(block_alignment, block_size))};
+    if (!result) {
+      throw std::bad_alloc{};
+    }
+    return result;
+  }
+
+  class file_descriptor {
+  public:
+    explicit file_descriptor(std::string const& filename)
+      : fd_{::open(filename.c_str(), O_RDONLY | O_CLOEXEC)}
+    {
+      if (fd_ < 0) {
+        throw cet::exception("hash_file")
+          << "Unable to open file " << filename << ": "
+          << std::strerror(errno) << '\n';
+      }
+    }
+    ~file_descriptor() noexcept { ::close(fd_); }
+
+    file_descriptor(file_descriptor const&) = delete;
+    file_descriptor& operator=(file_descriptor const&) = delete;
+
+    int
+    get() const
+    {
+      return fd_;
+    }
+
+  private:
+    int fd_;
+  };
+
+  // Returns false if the file could not be mapped.
+  bool
+  hash_mapped(int const fd, std::size_t const size, hash_sink const& sink)
+  {
+    void* const map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+      return false;
+    }
+    ::madvise(map, size, MADV_SEQUENTIAL);
+    try {
+      auto const* const begin = static_cast<char const*>(map);
+      for (std::size_t pos = 0; pos < size; pos += mapped_block_size) {
+        sink(begin + pos, std::min(mapped_block_size, size - pos));
+      }
+    }
+    catch (...) {
+      ::munmap(map, size);
+      throw;
+    }
+    ::munmap(map, size);
+    return true;
+  }
+}
+
+void
+cet::detail::read_file_blocks(std::string const& filename,
+                              bool const use_mmap,
+                              hash_sink const& sink)
+{
+  file_descriptor const fd{filename};
+  struct stat st;
+  if (::fstat(fd.get(), &st) != 0) {
+    throw cet::exception("hash_file") << "Unable to stat file " << filename
+                                      << ": " << std::strerror(errno) << '\n';
+  }
+  bool const regular = S_ISREG(st.st_mode);
+  if (use_mmap && regular && st.st_size > 0 &&
+      hash_mapped(fd.get(), st.st_size, sink)) {
+    return;
+  }
+#ifdef POSIX_FADV_SEQUENTIAL
+  if (regular) {
+    ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+#endif
+
+  auto const block = make_block();
+  for (;;) {
+    // Fill the block as far as possible, so the hasher sees large
+    // pieces even from pipes.
+    std::size_t filled{};
+    while (filled != block_size) {
+      auto const n =
+        ::read(fd.get(), block.get() + filled, block_size - filled);
+      if (n > 0) {
+        filled += n;
+      } else if (n == 0) {
+        break;
+      } else if (errno != EINTR) {
+        throw cet::exception("hash_file")
+          << "Error reading file " << filename << ": " << std::strerror(errno)
+          << '\n';
+      }
+    }
+    if (filled != 0) {
+      sink(block.get(), filled);
+    }
+    if (filled != block_size) {
+      return;
+    }
+  }
+}
+
+void
+cet::detail::read_stream_blocks(std::istream& is, hash_sink const& sink)
+{
+  auto const block = make_block();
+  while (is.read(block.get(), block_size) || is.gcount() > 0) {
+    sink(block.get(), is.gcount());
+  }
+  if (is.bad()) {
+    throw cet::exception("hash_file") << "Error reading stream.\n";
+  }
+}
+
+// ======================================================================
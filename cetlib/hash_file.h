@@ -0,0 +1,75 @@
+#ifndef cetlib_hash_file_h
+#define cetlib_hash_file_h
+
+// ======================================================================
+//
+// hash_file, hash_stream: Calculate the digest of the contents of a
+//                         file or stream without holding it in memory
+//
+// Hasher may be any type with a default c'tor and the member functions
+// update(void const* data, std::size_t size) and digest(), e.g.
+// cet::sha1, cet::MD5Digest or cet::crc32:
+//
+//   auto const digest = cet::hash_file<cet::sha1>("some/file");
+//
+// Files are read in large, page-aligned blocks that are passed to the
+// hasher without further copying. If use_mmap is true, regular files
+// are instead mapped into memory and hashed in place. Failure to open
+// or read the file throws cet::exception with category "hash_file".
+//
+// ======================================================================
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace cet {
+  template <typename Hasher>
+  auto hash_file(std::string const& filename, bool use_mmap = false);
+
+  template <typename Hasher>
+  auto hash_stream(std::istream& is);
+
+  namespace detail {
+    using hash_sink = std::function<void(void const* data, std::size_t size)>;
+
+    // Pass the contents of the file or stream to sink in successive
+    // blocks.
+    void read_file_blocks(std::string const& filename,
+                          bool use_mmap,
+                          hash_sink const& sink);
+    void read_stream_blocks(std::istream& is, hash_sink const& sink);
+  }
+}
+
+// ======================================================================
+
+template <typename Hasher>
+auto
+cet::hash_file(std::string const& filename, bool const use_mmap)
+{
+  Hasher hasher;
+  detail::read_file_blocks(
+    filename, use_mmap, [&hasher](void const* data, std::size_t size) {
+      hasher.update(data, size);
+    });
+  return hasher.digest();
+}
+
+template <typename Hasher>
+auto
+cet::hash_stream(std::istream& is)
+{
+  Hasher hasher;
+  detail::read_stream_blocks(is, [&hasher](void const* data, std::size_t size) {
+    hasher.update(data, size);
+  });
+  return hasher.digest();
+}
+
+#endif /* cetlib_hash_file_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,58 @@
+// ======================================================================
+//
+// hash_many: Calculate the digests of many independent messages
+//
+// ======================================================================
+
+#include "cetlib/hash_many.h"
+#include "cetlib/detail/for_each_range.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+  // Below this much data, starting threads costs more than it saves.
+  std::size_t constexpr min_bytes_per_thread{256u << 10};
+
+  // Messages are handed out in batches, so threads that draw short
+  // messages take more of them.
+  std::size_t constexpr batch_size{64};
+}
+
+void
+cet::detail::hash_many_for_each_batch(
+  std::size_t const n,
+  std::size_t const total_bytes,
+  unsigned nthreads,
+  std::function<void(std::size_t, std::size_t)> const& f)
+{
+  if (nthreads == 0) {
+    nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  auto const nbatches = (n + batch_size - 1) / batch_size;
+  std::size_t const max_threads = std::min<std::size_t>(
+    {nthreads, nbatches, total_bytes / min_bytes_per_thread});
+  if (max_threads < 2) {
+    if (n != 0) {
+      f(0, n);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_batch{0};
+  for_each_thread(static_cast<unsigned>(max_threads), [&](unsigned) {
+    try {
+      for (auto b = next_batch++; b < nbatches; b = next_batch++) {
+        auto const begin = b * batch_size;
+        f(begin, std::min(begin + batch_size, n));
+      }
+    }
+    catch (...) {
+      next_batch = nbatches; // Stop the other threads early.
+      throw;
+    }
+  });
+}
+
+// ======================================================================
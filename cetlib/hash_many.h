@@ -0,0 +1,120 @@
+#ifndef cetlib_hash_many_h
+#define cetlib_hash_many_h
+
+// ======================================================================
+//
+// hash_many: Calculate the digests of many independent messages
+//
+// The result holds, in order, the digest of each message. Each digest
+// is identical to that from hashing the message alone, e.g.
+// cet::sha1{message}.digest(). Hasher is any type usable with
+// cet::hash_file: cet::sha1, cet::MD5Digest, cet::crc32,
+// cet::fast_hasher64 or one of the cet::evp_digest family.
+//
+//   std::vector<std::string_view> records = ...;
+//   auto const digests = cet::hash_many<cet::sha1>(records);
+//
+// Each thread reuses one hasher for all of its messages (via reset(),
+// if Hasher provides it), avoiding the cost of setting up a hasher per
+// message. Batches of messages are distributed over up to nthreads
+// threads (0 means one per hardware thread). Small workloads are
+// hashed on the calling thread only.
+//
+// ======================================================================
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cet {
+  template <typename Hasher>
+  using hash_many_result_t =
+    std::vector<decltype(std::declval<Hasher&>().digest())>;
+
+  template <typename Hasher>
+  hash_many_result_t<Hasher> hash_many(std::string_view const* messages,
+                                       std::size_t n,
+                                       unsigned nthreads = 0);
+
+  // Messages is any contiguous container of std::string_view (e.g.
+  // std::vector or std::array).
+  template <typename Hasher,
+            typename Messages,
+            typename = decltype(std::data(std::declval<Messages const&>()))>
+  hash_many_result_t<Hasher> hash_many(Messages const& messages,
+                                       unsigned nthreads = 0);
+
+  namespace detail {
+    // Call f(begin, end) for consecutive ranges of [0, n), on up to
+    // nthreads threads; total_bytes is used to decide whether using
+    // more than one thread is worthwhile.
+    void hash_many_for_each_batch(
+      std::size_t n,
+      std::size_t total_bytes,
+      unsigned nthreads,
+      std::function<void(std::size_t begin, std::size_t end)> const& f);
+
+    template <typename Hasher, typename = void>
+    struct has_reset : std::false_type {};
+
+    template <typename Hasher>
+    struct has_reset<Hasher,
+                     std::void_t<decltype(std::declval<Hasher&>().reset())>>
+      : std::true_type {};
+  }
+}
+
+// ======================================================================
+
+template <typename Hasher>
+cet::hash_many_result_t<Hasher>
+cet::hash_many(std::string_view const* const messages,
+               std::size_t const n,
+               unsigned const nthreads)
+{
+  std::size_t total_bytes{};
+  for (std::size_t i = 0; i != n; ++i) {
+    total_bytes += messages[i].size();
+  }
+
+  hash_many_result_t<Hasher> result(n);
+  detail::hash_many_for_each_batch(
+    n,
+    total_bytes,
+    nthreads,
+    [messages, &result](std::size_t const begin, std::size_t const end) {
+      if constexpr (detail::has_reset<Hasher>::value) {
+        Hasher hasher;
+        for (std::size_t i = begin; i != end; ++i) {
+          hasher.reset();
+          hasher.update(messages[i].data(), messages[i].size());
+          result[i] = hasher.digest();
+        }
+      } else {
+        for (std::size_t i = begin; i != end; ++i) {
+          Hasher hasher;
+          hasher.update(messages[i].data(), messages[i].size());
+          result[i] = hasher.digest();
+        }
+      }
+    });
+  return result;
+}
+
+template <typename Hasher, typename Messages, typename>
+cet::hash_many_result_t<Hasher>
+cet::hash_many(Messages const& messages, unsigned const nthreads)
+{
+  return hash_many<Hasher>(
+    std::data(messages), std::size(messages), nthreads);
+}
+
+#endif /* cetlib_hash_many_h */
+
+// Local Variables:
+// mode: c++
+// End:
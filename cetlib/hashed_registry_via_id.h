@@ -0,0 +1,293 @@
+#ifndef cetlib_hashed_registry_via_id_h
+#define cetlib_hashed_registry_via_id_h
+
+// ======================================================================
+//
+// hashed_registry_via_id<K,V,Hash,KeyEqual>: A singleton hash map<K,V>
+//                                            requiring that V::id()
+//                                            exists and yields values
+//                                            of type K
+//
+// The interface is that of registry_via_id<K,V>, with lookups in
+// constant average time rather than by walking a tree.  Hash must be
+// provided for key types without a std::hash specialization.
+//
+// Differences from registry_via_id:
+//
+//  - Iteration, and get() without arguments, are in insertion order;
+//    sorted() returns a snapshot of the entries in key order.
+//  - put() of a range reserves room for the whole range first, and no
+//    put() allocates per entry; reserve() makes room in advance.
+//  - If Hash and KeyEqual are transparent (define is_transparent, as
+//    std::equal_to<> does), get() accepts any key type they accept, so
+//    that a lookup need not construct a K.
+//
+// As with registry_via_id, entries are never replaced or removed, and
+// references returned by get() stay valid.
+//
+// ======================================================================
+
+#include "cetlib/detail/open_addressing_map.h"
+#include "cetlib/registry_via_id.h"
+#include "cetlib_except/exception.h"
+
+#include <functional>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+namespace cet {
+  template <class K,
+            class V,
+            class Hash = std::hash<K>,
+            class KeyEqual = std::equal_to<>>
+  class hashed_registry_via_id;
+
+  namespace detail {
+    template <class Hash, class KeyEqual, class = void>
+    struct is_transparent_lookup : std::false_type {};
+
+    template <class Hash, class KeyEqual>
+    struct is_transparent_lookup<Hash,
+                                 KeyEqual,
+                                 std::void_t<typename Hash::is_transparent,
+                                             typename KeyEqual::is_transparent>>
+      : std::true_type {};
+  }
+}
+
+// ======================================================================
+
+template <class K, class V, class Hash, class KeyEqual>
+class cet::hashed_registry_via_id {
+  // non-instantiable (and non-copyable, just in case):
+  hashed_registry_via_id() = delete;
+  hashed_registry_via_id(hashed_registry_via_id const&) = delete;
+  void operator=(hashed_registry_via_id const&) = delete;
+
+  // Key types other than K accepted by get().
+  template <class Key>
+  using enable_if_lookup_key_t = std::enable_if_t<
+    !std::is_convertible_v<Key const&, K const&> &&
+    detail::is_transparent_lookup<Hash, KeyEqual>::value>;
+
+public:
+  using collection_type = detail::open_addressing_map<K, V, Hash, KeyEqual>;
+  using key_type = typename collection_type::key_type;
+  using mapped_type = typename collection_type::mapped_type;
+  using value_type = typename collection_type::value_type;
+  using size_type = typename collection_type::size_type;
+  using const_iterator = typename collection_type::const_iterator;
+
+  // observers:
+  static bool
+  empty()
+  {
+    return the_registry_().empty();
+  }
+  static size_type
+  size()
+  {
+    return the_registry_().size();
+  }
+
+  // iterators (insertion order):
+  static const_iterator
+  begin()
+  {
+    return the_registry_().begin();
+  }
+  static const_iterator
+  end()
+  {
+    return the_registry_().end();
+  }
+  static const_iterator
+  cbegin()
+  {
+    return the_registry_().cbegin();
+  }
+  static const_iterator
+  cend()
+  {
+    return the_registry_().cend();
+  }
+
+  // The entries in key order.
+  static std::vector<std::reference_wrapper<value_type const>>
+  sorted()
+  {
+    return the_registry_().sorted();
+  }
+
+  // mutators:
+  // Room for n entries in total.
+  static void
+  reserve(size_type const n)
+  {
+    the_registry_().reserve(n);
+  }
+  // A single V;
+  static typename detail::must_have_id<K, V>::type put(V const& value);
+  // A range of iterator to V.
+  template <class FwdIt>
+  static std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   mapped_type>>
+  put(FwdIt begin, FwdIt end);
+  // A range of iterator to std::pair<K, V>. For each pair, first ==
+  // second.id() is a prerequisite.
+  template <class FwdIt>
+  static std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   value_type>>
+  put(FwdIt begin, FwdIt end);
+  // A std::map, as used by registry_via_id. For each value_type,
+  // first == second.id() is a prerequisite.
+  static void put(std::map<K const, V> const& c);
+
+  // accessors:
+  static collection_type const&
+  get() noexcept
+  {
+    return the_registry_();
+  }
+  static V const& get(K const& key);
+  static bool get(K const& key, V& value) noexcept;
+  template <class Key, class = enable_if_lookup_key_t<Key>>
+  static V const& get(Key const& key);
+  template <class Key, class = enable_if_lookup_key_t<Key>>
+  static bool get(Key const& key, V& value) noexcept;
+
+private:
+  template <class Key>
+  static V const& get_(Key const& key);
+  template <class Key>
+  static bool get_(Key const& key, V& value) noexcept;
+
+  // encapsulated singleton:
+  static collection_type&
+  the_registry_()
+  {
+    static collection_type the_registry;
+    return the_registry;
+  }
+
+}; // hashed_registry_via_id<>
+
+// ----------------------------------------------------------------------
+// put() overloads:
+
+template <class K, class V, class Hash, class KeyEqual>
+typename cet::detail::must_have_id<K, V>::type
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::put(V const& value)
+{
+  K id = value.id();
+  the_registry_().emplace(id, value);
+  return id;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class FwdIt>
+inline auto
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::put(FwdIt b, FwdIt e)
+  -> std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   mapped_type>>
+{
+  auto& registry = the_registry_();
+  registry.reserve(registry.size() + std::distance(b, e));
+  for (; b != e; ++b)
+    registry.emplace(b->id(), *b);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class FwdIt>
+inline auto
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::put(FwdIt b, FwdIt e)
+  -> std::enable_if_t<
+    std::is_same_v<typename std::iterator_traits<FwdIt>::value_type,
+                   value_type>>
+{
+  auto& registry = the_registry_();
+  registry.reserve(registry.size() + std::distance(b, e));
+  for (; b != e; ++b)
+    registry.emplace(b->first, b->second);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+inline void
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::put(
+  std::map<K const, V> const& c)
+{
+  put(c.cbegin(), c.cend());
+}
+
+// ----------------------------------------------------------------------
+// get() overloads:
+
+template <class K, class V, class Hash, class KeyEqual>
+inline V const&
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::get(K const& key)
+{
+  return get_(key);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+inline bool
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::get(K const& key,
+                                                       V& value) noexcept
+{
+  return get_(key, value);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Key, class>
+inline V const&
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::get(Key const& key)
+{
+  return get_(key);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Key, class>
+inline bool
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::get(Key const& key,
+                                                       V& value) noexcept
+{
+  return get_(key, value);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Key>
+V const&
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::get_(Key const& key)
+{
+  auto const& registry = the_registry_();
+  auto const entry = registry.find(key);
+  if (entry == registry.cend())
+    throw cet::exception("cet::hashed_registry_via_id")
+      << "Key \"" << key << "\" not found in registry";
+  return entry->second;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Key>
+bool
+cet::hashed_registry_via_id<K, V, Hash, KeyEqual>::get_(Key const& key,
+                                                        V& value) noexcept
+{
+  auto const& registry = the_registry_();
+  auto const entry = registry.find(key);
+  if (entry == registry.cend())
+    return false;
+  value = entry->second;
+  return true;
+}
+
+#endif /* cetlib_hashed_registry_via_id_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -6,26 +6,20 @@
 // ======================================================================
 
 #include "cetlib/filepath_maker.h"
-#include "cetlib/includer.h"
+#include "cetlib/include.h"
 #include "cetlib_except/exception.h"
-#include <algorithm>
 #include <iostream>
-#include <iterator>
 #include <string>
 
 cet::filepath_maker identity_filepath;
 
 // ----------------------------------------------------------------------
 
+// The expansion is streamed, so memory use does not depend on the size
+// of the input; directives are handled as by cet::includer.
 int
 do_including(std::string const& from, std::ostream& to) try {
-  cet::includer inc(from, identity_filepath);
-
-  cet::includer::const_iterator it = inc.begin();
-  cet::includer::const_iterator end = inc.end();
-
-  std::ostream_iterator<char> out(to);
-  std::copy(it, end, out);
+  cet::include(from, identity_filepath, to);
 
   return 0;
 }
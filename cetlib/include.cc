@@ -5,25 +5,35 @@
 // ======================================================================
 
 #include "cetlib/include.h"
+#include "cetlib/filepath_maker.h"
 #include "cetlib/filesystem.h"
 #include "cetlib/search_path.h"
-#include "cetlib/split_by_regex.h"
 #include "cetlib/trim.h"
 #include "cetlib_except/coded_exception.h"
 
+#include <algorithm>
 #include <fstream>
-#include <regex>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <vector>
 
 // ----------------------------------------------------------------------
 
 namespace {
-  std::regex const reCarriageReturn{"\r"};
   std::string const include_lit{"#include \""};
   std::size_t const include_sz{include_lit.size()};
+
+  // As for includer, directives are the lines beginning with
+  // includer_lit, and must have the form #include "name":
+  std::string const includer_lit{"#include"};
+  std::size_t const includer_min_sz{includer_lit.size() + 3u};
+
+  std::size_t constexpr block_size{1u << 16};
 }
 
 namespace {
-  enum error { cant_open, cant_read, malformed };
+  enum error { cant_open, cant_read, malformed, recursive };
 
   std::string
   translate(error const code)
@@ -35,6 +45,8 @@ namespace {
       return "Can't read from supplied input stream:";
     case malformed:
       return "Malformed #include directive:";
+    case recursive:
+      return "Recursive #include directive:";
     default:
       return "Unknown code";
     }
@@ -42,46 +54,241 @@ namespace {
 
   using include_exception = cet::coded_exception<error, translate>;
 
-  std::vector<std::string>
-  getlines(std::istream& is)
+  // Collects the expansion, passing it to the sink in blocks.
+  class buffered_sink {
+  public:
+    explicit buffered_sink(cet::include_sink const& sink) : sink_{sink}
+    {
+      buffer_.reserve(block_size);
+    }
+
+    void
+    append(char const* const data, std::size_t const n)
+    {
+      buffer_.append(data, n);
+      if (buffer_.size() >= block_size)
+        flush();
+    }
+
+    void
+    flush()
+    {
+      if (!buffer_.empty()) {
+        sink_(buffer_.data(), buffer_.size());
+        buffer_.clear();
+      }
+    }
+
+  private:
+    cet::include_sink const& sink_;
+    std::string buffer_{};
+  };
+
+  // Copies the lines of in to out, each followed by a '\n', except
+  // for #include directives (lines beginning with prefix), which are
+  // passed, without their line terminators, to include_line. As
+  // for std::getline, lines are terminated by "\n", "\r\n" or "\r".
+  // Only the start of each line, and the whole of each #include
+  // directive, is buffered.
+  template <typename IncludeLine>
+  void
+  expand(std::istream& in,
+         std::string const& prefix,
+         buffered_sink& out,
+         IncludeLine include_line)
   {
-    std::vector<std::string> result;
-    for (std::string readline; std::getline(is, readline);) {
-      for (auto const& line : cet::split_by_regex(readline, reCarriageReturn)) {
-        result.emplace_back(line);
+    auto const block = std::make_unique<char[]>(block_size);
+    std::string line;      // Start of the current line, while buffered.
+    bool buffering{true};  // Whether the current line may be a directive.
+    bool skip_lf{false};   // Whether the last character read was '\r'.
+
+    auto const end_line = [&] {
+      if (!buffering) {
+        out.append("\n", 1);
+      } else if (line.compare(0, prefix.size(), prefix) == 0) {
+        include_line(line);
+      } else {
+        line.append(1, '\n');
+        out.append(line.data(), line.size());
+      }
+      line.clear();
+      buffering = true;
+    };
+
+    while (in.read(block.get(), block_size) || in.gcount() > 0) {
+      char const* p = block.get();
+      char const* const end = p + in.gcount();
+      while (p != end) {
+        if (skip_lf) {
+          skip_lf = false;
+          if (*p == '\n') {
+            ++p;
+            continue;
+          }
+        }
+        char const* const eol = std::find_if(
+          p, end, [](char const c) { return c == '\n' || c == '\r'; });
+        if (buffering) {
+          line.append(p, eol);
+          if (line.size() >= prefix.size() &&
+              line.compare(0, prefix.size(), prefix) != 0) {
+            // ordinary line
+            out.append(line.data(), line.size());
+            line.clear();
+            buffering = false;
+          }
+        } else {
+          out.append(p, eol - p);
+        }
+        if (eol == end)
+          break;
+        skip_lf = (*eol == '\r');
+        end_line();
+        p = eol + 1;
       }
     }
-    return result;
+
+    // unterminated last line:
+    if (!buffering || !line.empty())
+      end_line();
   }
-}
 
-using namespace cet::detail;
+  // The stack of the files being included, for detecting recursion.
+  class inclusion_stack {
+  public:
+    void
+    push(std::string const& fname)
+    {
+      if (std::find(fnames_.cbegin(), fnames_.cend(), fname) !=
+          fnames_.cend())
+        throw include_exception{recursive} << fname;
+      fnames_.push_back(fname);
+    }
+    void
+    pop()
+    {
+      fnames_.pop_back();
+    }
+
+  private:
+    std::vector<std::string> fnames_{};
+  };
+
+  void
+  include_files(std::istream& in, buffered_sink& out, inclusion_stack& stack)
+  {
+    if (!in)
+      throw include_exception{cant_read};
+
+    expand(in, include_lit, out, [&out, &stack](std::string line) {
+      cet::trim_right(line, "\t\r");
+      if (line.end()[-1] != '\"') // #include is missing trailing quote
+        throw include_exception{malformed} << line;
+
+      std::string const fname{
+        line.substr(include_sz, line.size() - include_sz - 1)};
+      std::ifstream f{fname.c_str(), std::ios_base::in};
+      if (!f)
+        throw include_exception{cant_open} << fname;
+      stack.push(fname);
+      include_files(f, out, stack);
+      stack.pop();
+    });
+  }
+
+  void
+  include_files(std::istream& in,
+                cet::search_path const& paths,
+                buffered_sink& out,
+                inclusion_stack& stack)
+  {
+    if (!in)
+      throw include_exception(cant_read);
+
+    expand(
+      in, include_lit, out, [&paths, &out, &stack](std::string const& line) {
+        if (line.end()[-1] != '\"') // #include is missing its trailing quote
+          throw include_exception(malformed) << line;
+
+        std::string const fname{
+          line.substr(include_sz, line.size() - include_sz - 1)};
+
+        std::string const filepath =
+          cet::is_absolute_filepath(fname) ? fname : paths.find_file(fname);
+        std::ifstream f{filepath.c_str(), std::ios_base::in};
+        if (!f) {
+          if (cet::is_absolute_filepath(fname))
+            throw include_exception(cant_open) << fname;
+          throw include_exception(cant_open)
+            << fname << "\nusing path: " << paths;
+        }
+        stack.push(filepath);
+        include_files(f, paths, out, stack);
+        stack.pop();
+      });
+  }
+
+  void
+  include_files(std::istream& in,
+                cet::filepath_maker& policy,
+                buffered_sink& out,
+                inclusion_stack& stack)
+  {
+    if (!in)
+      throw include_exception(cant_read);
+
+    expand(in, includer_lit, out, [&policy, &out, &stack](std::string line) {
+      cet::trim_right(line, " \t\r\n");
+      if (line.size() <= includer_min_sz // too short?
+          || line[8] != ' '              // missing separator?
+          || line[9] != '\"' || line.end()[-1] != '\"') // missing quote?
+        throw include_exception(malformed) << line;
+
+      std::string const fname{
+        line.substr(includer_min_sz - 1u, line.size() - includer_min_sz)};
+      std::string const filepath = policy(fname);
+      std::ifstream f{filepath.c_str(), std::ios_base::in};
+      if (!f)
+        throw include_exception(cant_open) << fname << " => " << filepath;
+      stack.push(filepath);
+      include_files(f, policy, out, stack);
+      stack.pop();
+    });
+  }
+}
 
 // ----------------------------------------------------------------------
 
 void
 cet::include(std::istream& in, std::string& result)
 {
-  if (!in)
-    throw include_exception{cant_read};
+  include(in, [&result](char const* const data, std::size_t const n) {
+    result.append(data, n);
+  });
+} // include()
 
-  for (auto& line : getlines(in)) {
-    if (line.find(include_lit) != 0) { // ordinary line
-      result.append(line).append(1, '\n');
-      continue;
-    }
-    trim_right(line, "\t\r");
-    if (line.end()[-1] != '\"') // #include is missing trailing quote
-      throw include_exception{malformed} << line;
-
-    std::string const fname{
-      line.substr(include_sz, line.size() - include_sz - 1)};
-    std::ifstream f{fname.c_str(), std::ios_base::in};
-    if (!f)
-      throw include_exception{cant_open} << fname;
-    include(f, result);
-  } // for
+void
+cet::include(std::istream& in, std::ostream& out)
+{
+  include(in, [&out](char const* const data, std::size_t const n) {
+    out.write(data, n);
+  });
+} // include()
 
+void
+cet::include(std::istream& in, include_sink const& sink)
+{
+  buffered_sink out{sink};
+  inclusion_stack stack;
+  try {
+    include_files(in, out, stack);
+  }
+  catch (...) {
+    // Pass on the expansion up to the error.
+    out.flush();
+    throw;
+  }
+  out.flush();
 } // include()
 
 // ----------------------------------------------------------------------
@@ -91,38 +298,81 @@ cet::include(std::istream& in,
              std::string const& search_path_arg,
              std::string& result)
 {
-  cet::search_path const paths{search_path_arg};
+  include(in,
+          search_path_arg,
+          [&result](char const* const data, std::size_t const n) {
+            result.append(data, n);
+          });
+} // include()
 
-  if (!in)
-    throw include_exception(cant_read);
+void
+cet::include(std::istream& in,
+             std::string const& search_path_arg,
+             std::ostream& out)
+{
+  include(
+    in, search_path_arg, [&out](char const* const data, std::size_t const n) {
+      out.write(data, n);
+    });
+} // include()
 
-  for (auto const& line : getlines(in)) {
-    if (line.find(include_lit) != 0) { // ordinary line
-      result.append(line).append(1, '\n');
-      continue;
-    }
+void
+cet::include(std::istream& in,
+             std::string const& search_path_arg,
+             include_sink const& sink)
+{
+  cet::search_path const paths{search_path_arg};
+  buffered_sink out{sink};
+  inclusion_stack stack;
+  try {
+    include_files(in, paths, out, stack);
+  }
+  catch (...) {
+    // Pass on the expansion up to the error.
+    out.flush();
+    throw;
+  }
+  out.flush();
+} // include()
 
-    if (line.end()[-1] != '\"') // #include is missing its trailing quote
-      throw include_exception(malformed) << line;
+// ----------------------------------------------------------------------
 
-    std::string const fname{
-      line.substr(include_sz, line.size() - include_sz - 1)};
+void
+cet::include(std::string const& filename,
+             filepath_maker& policy,
+             std::ostream& out)
+{
+  include(
+    filename, policy, [&out](char const* const data, std::size_t const n) {
+      out.write(data, n);
+    });
+} // include()
 
-    if (is_absolute_filepath(fname)) {
-      std::ifstream f{fname.c_str(), std::ios_base::in};
-      if (!f)
-        throw include_exception(cant_open) << fname;
-      include(f, search_path_arg, result);
+void
+cet::include(std::string const& filename,
+             filepath_maker& policy,
+             include_sink const& sink)
+{
+  buffered_sink out{sink};
+  inclusion_stack stack;
+  try {
+    if (filename == "-") {
+      include_files(std::cin, policy, out, stack);
     } else {
-      std::ifstream f{paths.find_file(fname).c_str(), std::ios_base::in};
-      if (!f) {
-        throw include_exception(cant_open)
-          << fname << "\nusing path: " << paths;
-      }
-      include(f, search_path_arg, result);
+      std::string const filepath = policy(filename);
+      std::ifstream f{filepath.c_str(), std::ios_base::in};
+      if (!f)
+        throw include_exception(cant_open) << filename << " => " << filepath;
+      stack.push(filepath);
+      include_files(f, policy, out, stack);
     }
-  } // for
-
+  }
+  catch (...) {
+    // Pass on the expansion up to the error.
+    out.flush();
+    throw;
+  }
+  out.flush();
 } // include()
 
 // ======================================================================
@@ -5,16 +5,51 @@
 //
 // include: File->string, interpolating #include'd files along the way
 //
+// The variants taking an std::ostream or an include_sink write the
+// expansion as it is produced, reading the input in blocks, so their
+// memory use does not depend on the size of the input. The sink is
+// called with successive pieces of the expansion.
+//
+// The variants taking a filename and a filepath_maker expand the named
+// file ("-" for standard input) as cet::includer does: each line
+// beginning with "#include" must have the form #include "name", less
+// trailing whitespace, and the policy maps each name to the path of the
+// file to read.  The variants taking an std::istream recognize only the
+// lines beginning with '#include "', passing other lines through.
+//
 // ======================================================================
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <string>
 
 namespace cet {
+  class filepath_maker;
+
+  using include_sink = std::function<void(char const* data, std::size_t n)>;
+
   void include(std::istream& in, std::string& result);
   void include(std::istream& in,
                std::string const& search_path_arg,
                std::string& result);
+
+  void include(std::istream& in, std::ostream& out);
+  void include(std::istream& in,
+               std::string const& search_path_arg,
+               std::ostream& out);
+
+  void include(std::istream& in, include_sink const& sink);
+  void include(std::istream& in,
+               std::string const& search_path_arg,
+               include_sink const& sink);
+
+  void include(std::string const& filename,
+               filepath_maker& policy,
+               std::ostream& out);
+  void include(std::string const& filename,
+               filepath_maker& policy,
+               include_sink const& sink);
 }
 
 // ======================================================================
@@ -9,12 +9,30 @@
 
 #include "boost/filesystem.hpp"
 #include "cetlib/filepath_maker.h"
-#include "cetlib/split_by_regex.h"
+#include "cetlib/nybbler.h"
+#include "cetlib/sha1.h"
 #include "cetlib/trim.h"
 #include "cetlib_except/coded_exception.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using cet::includer;
 
@@ -23,7 +41,8 @@ namespace bfs = boost::filesystem;
 // ----------------------------------------------------------------------
 
 namespace {
-  std::regex const reCarriageReturn{"\r"};
+  std::string const inc_lit{"#include"};
+  std::size_t const min_sz{inc_lit.size() + 3u};
 
   namespace detail {
     enum error { cant_open, cant_read, malformed, recursive };
@@ -58,17 +77,269 @@ namespace {
       return "<end>";
     }
 
-    std::vector<std::string>
-    getlines(std::istream& is)
+    // The complete contents of a file or stream: regular files are
+    // memory-mapped; anything else is read in blocks.
+    class source_text {
+    public:
+      // If populate, the contents of a memory-mapped file are read
+      // immediately, rather than as they are accessed.
+      explicit source_text(std::string const& filepath,
+                           bool populate = false);
+      explicit source_text(std::istream& is);
+      ~source_text() noexcept;
+
+      source_text(source_text const&) = delete;
+      source_text& operator=(source_text const&) = delete;
+
+      explicit operator bool() const { return ok_; }
+      char const*
+      begin() const
+      {
+        return data_;
+      }
+      char const*
+      end() const
+      {
+        return data_ + size_;
+      }
+      std::int64_t
+      mtime() const
+      {
+        return mtime_;
+      }
+
+    private:
+      bool ok_{false};
+      void* map_{MAP_FAILED};
+      std::string buffer_{};
+      char const* data_{buffer_.data()};
+      std::size_t size_{};
+      std::int64_t mtime_{-1}; // Files only.
+    };
+
+    std::int64_t
+    mtime_of(struct stat const& st)
+    {
+#ifdef __APPLE__
+      auto const& ts = st.st_mtimespec;
+#else
+      auto const& ts = st.st_mtim;
+#endif
+      return ts.tv_sec * std::int64_t{1000000000} + ts.tv_nsec;
+    }
+
+    std::size_t constexpr block_size{1u << 16};
+
+    source_text::source_text(std::string const& filepath, bool const populate)
     {
-      std::vector<std::string> result;
-      for (std::string readline; std::getline(is, readline);) {
-        for (auto const& line :
-             cet::split_by_regex(readline, reCarriageReturn)) {
-          result.emplace_back(line);
+      int const fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        return;
+      }
+      struct stat st;
+      if (::fstat(fd, &st) == 0) {
+        mtime_ = mtime_of(st);
+        if (S_ISREG(st.st_mode) && st.st_size > 0) {
+          int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+          if (populate) {
+            flags |= MAP_POPULATE;
+          }
+#endif
+          map_ = ::mmap(nullptr, st.st_size, PROT_READ, flags, fd, 0);
         }
       }
-      return result;
+      if (map_ != MAP_FAILED) {
+        ::madvise(map_, st.st_size, MADV_SEQUENTIAL);
+        data_ = static_cast<char const*>(map_);
+        size_ = st.st_size;
+      } else {
+        char block[block_size];
+        for (;;) {
+          auto const n = ::read(fd, block, sizeof block);
+          if (n > 0) {
+            buffer_.append(block, n);
+          } else if (n == 0 || errno != EINTR) {
+            break;
+          }
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+      }
+      ::close(fd);
+      ok_ = true;
+    }
+
+    source_text::source_text(std::istream& is) : ok_{static_cast<bool>(is)}
+    {
+      if (!ok_) {
+        return;
+      }
+      char block[block_size];
+      while (is.read(block, sizeof block) || is.gcount() > 0) {
+        buffer_.append(block, is.gcount());
+      }
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+    }
+
+    source_text::~source_text() noexcept
+    {
+      if (map_ != MAP_FAILED) {
+        ::munmap(map_, size_);
+      }
+    }
+
+    // The end of the line starting at p: the first '\n' or, if the
+    // text contains carriage returns, the first '\r' or '\n'.
+    char const*
+    find_eol(char const* const p, char const* const end, bool const has_cr)
+    {
+      if (!has_cr) {
+        auto const nl = std::memchr(p, '\n', end - p);
+        return nl ? static_cast<char const*>(nl) : end;
+      }
+      return std::find_if(
+        p, end, [](char const c) { return c == '\n' || c == '\r'; });
+    }
+
+    // The start of the line following the one ending at eol.
+    char const*
+    next_line(char const* const eol, char const* const end)
+    {
+      char const* next = (eol == end) ? end : eol + 1;
+      if (next != end && *eol == '\r' && *next == '\n')
+        ++next;
+      return next;
+    }
+
+    bool
+    is_include(char const* const p, char const* const eol)
+    {
+      return std::size_t(eol - p) >= inc_lit.size() &&
+             std::equal(inc_lit.cbegin(), inc_lit.cend(), p);
+    }
+
+    bool
+    well_formed(std::string const& line)
+    {
+      return !(line.size() <= min_sz // too short?
+               || line[8] != ' '     // missing separator?
+               || line[9] != '\"' || line.end()[-1] != '\"' // missing quote?
+      );
+    }
+
+    std::string
+    included_filename(std::string const& line)
+    {
+      return line.substr(min_sz - 1u, line.size() - min_sz);
+    }
+
+    // The cache (see includer.h) holds, in order: the header; the
+    // source_file records of the include closure; and the includer's
+    // text_, nl_positions_ and frames_. Numbers are stored as native
+    // 64-bit integers, and strings as their length followed by their
+    // characters.
+    std::string const cache_magic{"cet::includer cache 2"};
+    std::uint64_t constexpr cache_byte_order{0x0102030405060708};
+
+    std::string
+    cache_filepath(std::string const& cache_dir, std::string const& filepath)
+    {
+      auto const digest = cet::sha1{filepath}.digest();
+      std::string const key(digest.cbegin(), digest.cend());
+      return cache_dir + '/' + cet::nybbler{key}.as_hex() + ".inc";
+    }
+
+    std::string
+    digest_of(char const* const begin, char const* const end)
+    {
+      auto const digest =
+        cet::sha1{begin, static_cast<std::size_t>(end - begin)}.digest();
+      return std::string(digest.cbegin(), digest.cend());
+    }
+
+    void
+    put(std::string& blob, std::uint64_t const n)
+    {
+      blob.append(reinterpret_cast<char const*>(&n), sizeof n);
+    }
+
+    void
+    put(std::string& blob, std::string const& s)
+    {
+      put(blob, s.size());
+      blob.append(s);
+    }
+
+    class blob_reader {
+    public:
+      blob_reader(char const* const begin, char const* const end)
+        : p_{begin}, end_{end}
+      {}
+
+      bool
+      get(std::uint64_t& n)
+      {
+        if (std::size_t(end_ - p_) < sizeof n)
+          return false;
+        std::memcpy(&n, p_, sizeof n);
+        p_ += sizeof n;
+        return true;
+      }
+
+      bool
+      get(std::string& s)
+      {
+        std::uint64_t n;
+        if (!get(n) || std::size_t(end_ - p_) < n)
+          return false;
+        s.assign(p_, n);
+        p_ += n;
+        return true;
+      }
+
+      bool
+      done() const
+      {
+        return p_ == end_;
+      }
+
+    private:
+      char const* p_;
+      char const* end_;
+    };
+
+    // Whether, per policy, the filename resolves to the filepath.
+    bool
+    resolves_to(cet::filepath_maker& policy_filename,
+                std::string const& filename,
+                std::string const& filepath) try {
+      return policy_filename(filename) == filepath;
+    }
+    catch (...) {
+      // Left for the expansion to report.
+      return false;
+    }
+
+    // Whether the file is as recorded: same size, and same
+    // modification time or contents.
+    bool
+    unchanged(std::string const& filepath,
+              std::uint64_t const size,
+              std::uint64_t const mtime,
+              std::string const& digest)
+    {
+      struct stat st;
+      if (::stat(filepath.c_str(), &st) != 0 ||
+          std::uint64_t(st.st_size) != size) {
+        return false;
+      }
+      if (std::uint64_t(mtime_of(st)) == mtime) {
+        return true;
+      }
+      source_text const src{filepath};
+      return src && digest_of(src.begin(), src.end()) == digest;
     }
 
   } // ::detail.
@@ -93,6 +364,211 @@ namespace {
 
 using namespace ::detail;
 
+// ----------------------------------------------------------------------
+// includer::prefetcher: reads files concurrently, ahead of their
+// expansion by the includer.
+//
+// Worker threads take files from a queue, read them, and resolve the
+// filenames of their #include directives, queueing the resulting files
+// that are no deeper than the maximum depth and not already known.
+// This calls the lookup policy speculatively, so the policy must be
+// pure (see filepath_maker.h). Filename resolution is memoized, and
+// serialized (lookup policies need not be thread-safe): the includer
+// resolves its filenames through the prefetcher, so it sees the same
+// results and errors as if it had made the calls itself.
+
+class includer::prefetcher {
+public:
+  prefetcher(cet::filepath_maker& policy_filename,
+             unsigned max_depth,
+             unsigned nthreads);
+  ~prefetcher() noexcept;
+
+  prefetcher(prefetcher const&) = delete;
+  prefetcher& operator=(prefetcher const&) = delete;
+
+  // Start reading the top-level file and those it #includes.
+  void start(std::string const& filepath);
+
+  // Per policy, the path to the file.
+  std::string filepath(std::string const& filename);
+
+  // The contents of the file, or nullptr if it was not prefetched.
+  std::shared_ptr<source_text const> contents(std::string const& filepath);
+
+private:
+  struct resolution {
+    std::string filepath;
+    std::exception_ptr error;
+  };
+  struct file {
+    bool done{false};
+    std::shared_ptr<source_text const> contents{};
+  };
+
+  void queue(std::string const& filepath, unsigned depth);
+  void work();
+  void stop() noexcept;
+
+  cet::filepath_maker& policy_filename_;
+  unsigned const max_depth_;
+
+  std::mutex policy_mutex_{};
+  std::map<std::string, resolution> resolutions_{};
+
+  std::mutex mutex_{};
+  std::condition_variable cv_{};
+  std::deque<std::pair<std::string, unsigned>> queue_{};
+  std::map<std::string, file> files_{};
+  bool stop_{false};
+  std::vector<std::thread> threads_{};
+};
+
+includer::prefetcher::prefetcher(cet::filepath_maker& policy_filename,
+                                 unsigned const max_depth,
+                                 unsigned const nthreads)
+  : policy_filename_{policy_filename}, max_depth_{max_depth}
+{
+  threads_.reserve(nthreads);
+  try {
+    for (unsigned i = 0; i != nthreads; ++i) {
+      threads_.emplace_back([this] { work(); });
+    }
+  }
+  catch (...) {
+    // The destructor is not called: stop the threads already started.
+    stop();
+    throw;
+  }
+}
+
+includer::prefetcher::~prefetcher() noexcept
+{
+  stop();
+}
+
+void
+includer::prefetcher::stop() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& t : threads_) {
+    t.join();
+  }
+}
+
+void
+includer::prefetcher::start(std::string const& filepath)
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+  queue(filepath, 0);
+}
+
+std::string
+includer::prefetcher::filepath(std::string const& filename)
+{
+  std::lock_guard<std::mutex> lock{policy_mutex_};
+  auto it = resolutions_.find(filename);
+  if (it == resolutions_.end()) {
+    resolution r;
+    try {
+      r.filepath = policy_filename_(filename);
+    }
+    catch (...) {
+      r.error = std::current_exception();
+    }
+    it = resolutions_.emplace(filename, std::move(r)).first;
+  }
+  if (it->second.error) {
+    std::rethrow_exception(it->second.error);
+  }
+  return it->second.filepath;
+}
+
+std::shared_ptr<source_text const>
+includer::prefetcher::contents(std::string const& filepath)
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  auto const it = files_.find(filepath);
+  if (it == files_.end()) {
+    return nullptr;
+  }
+  cv_.wait(lock, [it] { return it->second.done; });
+  return it->second.contents;
+}
+
+void
+includer::prefetcher::queue(std::string const& filepath, unsigned const depth)
+{
+  // mutex_ must be held.
+  if (files_.emplace(filepath, file{}).second) {
+    queue_.emplace_back(filepath, depth);
+    cv_.notify_one();
+  }
+}
+
+void
+includer::prefetcher::work()
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  for (;;) {
+    cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (stop_) {
+      return;
+    }
+    auto const [path, depth] = queue_.front();
+    queue_.pop_front();
+    lock.unlock();
+
+    std::shared_ptr<source_text const> src;
+    std::vector<std::string> included;
+    try {
+      src = std::make_shared<source_text const>(path, true);
+      if (*src && depth < max_depth_) {
+        bool const has_cr =
+          std::memchr(src->begin(), '\r', src->end() - src->begin());
+        for (char const* p = src->begin(); p != src->end();) {
+          char const* const eol = find_eol(p, src->end(), has_cr);
+          if (is_include(p, eol)) {
+            std::string line{p, eol};
+            trim_right(line, " \t\r\n");
+            auto const filename = well_formed(line) ?
+                                    included_filename(line) :
+                                    std::string{"-"};
+            if (filename != "-") {
+              try {
+                included.push_back(filepath(filename));
+              }
+              catch (...) {
+                // Remembered, for the includer to report.
+              }
+            }
+          }
+          p = next_line(eol, src->end());
+        }
+      }
+    }
+    catch (...) {
+      // Leave it to the includer to read the file itself.
+      src.reset();
+    }
+
+    lock.lock();
+    auto& f = files_[path];
+    f.done = true;
+    f.contents = std::move(src);
+    for (auto const& filepath : included) {
+      queue(filepath, depth + 1);
+    }
+    cv_.notify_all();
+  }
+}
+
+// ----------------------------------------------------------------------
+
 includer::includer(std::string const& filename,
                    cet::filepath_maker& policy_filename)
   : frames_{frame(0, begin_string(), 0, text_.size())}
@@ -108,34 +584,81 @@ includer::includer(std::istream& is, cet::filepath_maker& policy_filename)
   frames_.emplace_back(0, end_string(), 0, text_.size());
 }
 
+includer::includer(std::string const& filename,
+                   cet::filepath_maker& policy_filename,
+                   std::string const& cache_dir)
+  : frames_{frame(0, begin_string(), 0, text_.size())}
+{
+  // expand filename to obtain, per policy, path to file:
+  bool const use_cin = (filename == "-");
+  std::string const filepath = use_cin ? filename : policy_filename(filename);
+  std::string const cache_file =
+    use_cin ? std::string{} : cache_filepath(cache_dir, filepath);
+  if (!use_cin && read_cache(cache_file, policy_filename))
+    return;
+
+  record_sources_ = !use_cin;
+  include(0, filename, filepath, policy_filename);
+  frames_.emplace_back(0, end_string(), 0, text_.size());
+  if (record_sources_)
+    write_cache(cache_file);
+  record_sources_ = false;
+  sources_ = {};
+}
+
+includer::includer(std::string const& filename,
+                   cet::filepath_maker& policy_filename,
+                   prefetch const options)
+  : frames_{frame(0, begin_string(), 0, text_.size())}
+{
+  // expand filename to obtain, per policy, path to file:
+  bool const use_cin = (filename == "-");
+  std::string const filepath = use_cin ? filename : policy_filename(filename);
+  if (use_cin || !policy_filename.is_pure()) {
+    include(0, filename, filepath, policy_filename);
+    frames_.emplace_back(0, end_string(), 0, text_.size());
+    return;
+  }
+
+  unsigned const nthreads =
+    options.nthreads ? options.nthreads :
+                       std::max(std::thread::hardware_concurrency(), 1u);
+  prefetcher pf{policy_filename, options.depth, nthreads};
+  pf.start(filepath);
+  prefetcher_ = &pf;
+  include(0, filename, filepath, policy_filename);
+  prefetcher_ = nullptr;
+  frames_.emplace_back(0, end_string(), 0, text_.size());
+}
+
 includer::posinfo
 includer::get_posinfo(const_iterator const& it) const
 {
-  // locate the frame corresponding to the given iterator:
-  uint textpos = it - text_.begin();
-  uint framenum;
-  for (framenum = 1u; framenum != frames_.size(); ++framenum)
-    if (textpos < frames_[framenum].starting_textpos)
-      break;
-  frame const& this_frame = frames_[--framenum];
-
-  // determine the line number within the corresponding file:
-  uint delta_line_num{};
-  if (this_frame.starting_textpos != textpos) {
-    auto const this_frame_begin = this_frame.nl_positions.cbegin();
-    auto const this_frame_end = this_frame.nl_positions.cend();
-    auto const lower =
-      std::upper_bound(this_frame_begin, this_frame_end, textpos);
-    delta_line_num = std::distance(this_frame_begin, lower);
-  }
-  uint const linenum = this_frame.starting_linenum + delta_line_num;
+  uint const textpos = it - text_.begin();
+
+  // locate the frame corresponding to the given iterator, i.e. the last
+  // one starting at or before textpos:
+  auto const frame_it = std::upper_bound(
+    frames_.cbegin() + 1,
+    frames_.cend(),
+    textpos,
+    [](uint const pos, frame const& f) { return pos < f.starting_textpos; });
+  uint const framenum = std::distance(frames_.cbegin(), frame_it) - 1u;
+  frame const& this_frame = frames_[framenum];
+
+  // determine the line number within the corresponding file from the
+  // number of new-lines between the start of the frame and textpos:
+  auto const nl_begin = nl_positions_.cbegin();
+  auto const line_it =
+    std::upper_bound(nl_begin, nl_positions_.cend(), textpos);
+  auto const frame_line_it =
+    std::upper_bound(nl_begin, line_it, this_frame.starting_textpos);
+  uint const linenum =
+    this_frame.starting_linenum + std::distance(frame_line_it, line_it);
 
   // determine the character position within the corresponding line:
-  uint const newlinepos =
-    textpos == 0u ? std::string::npos : text_.find_last_of('\n', textpos - 1u);
-  uint const charpos = newlinepos == std::string::npos ?
-                         textpos + 1 :
-                         textpos - text_.find_last_of('\n', textpos - 1u);
+  uint const linepos = (line_it == nl_begin) ? 0u : line_it[-1];
+  uint const charpos = textpos - linepos + 1u;
   return {textpos, linenum, charpos, framenum};
 }
 
@@ -161,7 +684,10 @@ includer::highlighted_whereis(const_iterator const& it) const
          << ", of file \"" << frames_[pos.framenum].filename << '\"'
          << backtrace(frames_[pos.framenum].including_framenum) << "\n\n";
   auto cp0 = pos.charpos - 1;
-  uint eol = text_.find_first_of('\n', pos.textpos);
+  auto const nl_it =
+    std::upper_bound(nl_positions_.cbegin(), nl_positions_.cend(), pos.textpos);
+  uint const eol =
+    (nl_it == nl_positions_.cend()) ? std::string::npos : *nl_it - 1u;
   result << text_.substr(pos.textpos - cp0,
                          (eol == std::string::npos) ?
                            std::string::npos :
@@ -187,12 +713,22 @@ includer::include(int including_framenum,
                   std::string const& filename,
                   cet::filepath_maker& policy_filename)
 {
-  static std::string const inc_lit = std::string("#include");
-  static uint const min_sz = inc_lit.size() + 3u;
-
   // expand filename to obtain, per policy, path to file:
   bool const use_cin = (filename == "-");
-  std::string const filepath = use_cin ? filename : policy_filename(filename);
+  std::string const filepath =
+    use_cin     ? filename :
+    prefetcher_ ? prefetcher_->filepath(filename) :
+                  policy_filename(filename);
+  include(including_framenum, filename, filepath, policy_filename);
+}
+
+void
+includer::include(int including_framenum,
+                  std::string const& filename,
+                  std::string const& filepath,
+                  cet::filepath_maker& policy_filename)
+{
+  bool const use_cin = (filename == "-");
   std::string const canonical_filepath =
     use_cin ? canonicalizePath(filepath) : filepath;
 
@@ -207,56 +743,34 @@ includer::include(int including_framenum,
     recursionStack_.emplace_back(canonical_filepath);
   }
 
-  // open the #included file:
-  std::ifstream ifs;
-  if (!use_cin)
-    ifs.open(filepath.c_str(), std::ifstream::in);
-  std::istream& f = use_cin ? std::cin : ifs;
-  if (!f)
+  // open and read (or map) the #included file, unless prefetched:
+  std::shared_ptr<source_text const> src_ptr =
+    (prefetcher_ && !use_cin) ? prefetcher_->contents(filepath) : nullptr;
+  if (!src_ptr) {
+    src_ptr = use_cin ? std::make_shared<source_text const>(std::cin) :
+                        std::make_shared<source_text const>(filepath);
+  }
+  source_text const& src = *src_ptr;
+  if (!src)
     throw inc_exception(cant_open)
       << filename << " => " << filepath << backtrace(frames_.size() - 1u);
 
-  int const starting_linenum = 1;
-  frame new_frame(including_framenum, filepath, starting_linenum, text_.size());
-
-  int linenum = 0;
-  // iterate over each line of the input file:
-  for (auto& line : getlines(f)) {
-    ++linenum;
-    if (line.find(inc_lit) != 0) { // ordinary line (not an #include)
-      text_.append(line).append(1, '\n');
-      new_frame.nl_positions.push_back(text_.size()); // Record newline
-      continue;
-    }
-
-    // save buffered text:
-    frames_.push_back(new_frame);
-
-    // record this #include's place:
-    new_frame.starting_linenum = linenum;
-    new_frame.starting_textpos = text_.size();
-    frames_.push_back(new_frame);
-
-    // validate the rest of the #include line's syntax:
-    trim_right(line, " \t\r\n");
-    if (line.size() <= min_sz                        // too short?
-        || line[8] != ' '                            // missing separator?
-        || line[9] != '\"' || line.end()[-1] != '\"' // missing either quote?
-    )
-      throw inc_exception(malformed)
-        << line << "\n at line " << linenum << " of file " << filepath;
-
-    // process the #include:
-    std::string nextfilename(line.substr(min_sz - 1u, line.size() - min_sz));
-    include(frames_.size() - 1u, nextfilename, policy_filename);
-
-    // prepare to resume where we left off:
-    new_frame.starting_linenum = linenum + 1;
-    new_frame.starting_textpos = text_.size();
-  } // for
+  // record the file for the cache (standard input is not cacheable):
+  if (record_sources_ && use_cin) {
+    record_sources_ = false;
+  } else if (record_sources_) {
+    sources_.push_back({filename,
+                        filepath,
+                        src.end() - src.begin(),
+                        src.mtime(),
+                        digest_of(src.begin(), src.end())});
+  }
 
-  // save final buffered text:
-  frames_.push_back(new_frame);
+  int const starting_linenum = 1;
+  include(frame(including_framenum, filepath, starting_linenum, text_.size()),
+          src.begin(),
+          src.end(),
+          policy_filename);
 
   // Done with this file.
   recursionStack_.pop_back();
@@ -265,31 +779,64 @@ includer::include(int including_framenum,
 void
 includer::include(std::istream& f, cet::filepath_maker& policy_filename)
 {
-  static std::string const inc_lit = std::string("#include");
-  static uint const min_sz = inc_lit.size() + 3u;
-
   // expand filename to obtain, per policy, absolute path to file:
   std::string const filepath = "-";
 
-  // check the open file:
-  if (!f)
+  // check and read the open file:
+  source_text const src{f};
+  if (!src)
     throw inc_exception(cant_open)
       << filepath << backtrace(frames_.size() - 1u);
 
   int const starting_linenum = 1;
-  frame new_frame(0, filepath, starting_linenum, text_.size());
+  include(frame(0, filepath, starting_linenum, text_.size()),
+          src.begin(),
+          src.end(),
+          policy_filename);
+}
+
+void
+includer::include(frame new_frame,
+                  char const* const begin,
+                  char const* const end,
+                  cet::filepath_maker& policy_filename)
+{
+  // Lines are terminated by "\n", "\r\n" or a lone "\r"; each is
+  // replaced by a single '\n' in text_.
+  bool const has_cr = std::memchr(begin, '\r', end - begin) != nullptr;
+  if (text_.capacity() - text_.size() < std::size_t(end - begin) + 1u) {
+    text_.reserve(
+      std::max(text_.size() + (end - begin) + 1u, 2u * text_.capacity()));
+  }
+
+  // Consecutive ordinary lines terminated by a plain '\n' appear
+  // unchanged in text_: they are copied as one span, [span_begin, p),
+  // once another kind of line is reached. Newline positions are
+  // recorded as they will be after the copy.
+  char const* span_begin = begin;
 
   int linenum = 0;
   // iterate over each line of the input file:
-  for (auto& line : getlines(f)) {
+  for (char const* p = begin; p != end;) {
+    char const* const eol = find_eol(p, end, has_cr);
+    char const* const next = next_line(eol, end);
     ++linenum;
-    if (line.find(inc_lit) != 0) { // ordinary line (not an #include)
-      text_.append(line).append(1, '\n');
-      new_frame.nl_positions.push_back(text_.size()); // Record newline
+
+    if (!is_include(p, eol)) {
+      // ordinary line (not an #include)
+      if (eol != end && *eol == '\n') {
+        nl_positions_.push_back(text_.size() + (next - span_begin));
+      } else {
+        text_.append(span_begin, p).append(p, eol).append(1, '\n');
+        nl_positions_.push_back(text_.size()); // Record newline
+        span_begin = next;
+      }
+      p = next;
       continue;
     }
 
     // save buffered text:
+    text_.append(span_begin, p);
     frames_.push_back(new_frame);
 
     // record this #include's place:
@@ -298,25 +845,138 @@ includer::include(std::istream& f, cet::filepath_maker& policy_filename)
     frames_.push_back(new_frame);
 
     // validate the rest of the #include line's syntax:
+    std::string line{p, eol};
     trim_right(line, " \t\r\n");
-    if (line.size() <= min_sz                        // too short?
-        || line[8] != ' '                            // missing separator?
-        || line[9] != '\"' || line.end()[-1] != '\"' // missing either quote?
-    )
-      throw inc_exception(malformed)
-        << line << "\n at line " << linenum << " of file " << filepath;
+    if (!well_formed(line))
+      throw inc_exception(malformed) << line << "\n at line " << linenum
+                                     << " of file " << new_frame.filename;
 
     // process the #include:
-    std::string nextfilename(line.substr(min_sz - 1u, line.size() - min_sz));
-    include(frames_.size() - 1u, nextfilename, policy_filename);
+    include(frames_.size() - 1u, included_filename(line), policy_filename);
 
     // prepare to resume where we left off:
     new_frame.starting_linenum = linenum + 1;
     new_frame.starting_textpos = text_.size();
+    span_begin = p = next;
   } // for
 
   // save final buffered text:
-  frames_.push_back(new_frame);
+  text_.append(span_begin, end);
+  frames_.push_back(std::move(new_frame));
+}
+
+bool
+includer::read_cache(std::string const& cache_file,
+                     cet::filepath_maker& policy_filename)
+{
+  source_text const blob{cache_file};
+  if (!blob)
+    return false;
+  blob_reader in{blob.begin(), blob.end()};
+
+  // check the header and the files of the include closure:
+  std::string magic;
+  std::uint64_t byte_order, n_sources;
+  if (!in.get(magic) || magic != cache_magic || !in.get(byte_order) ||
+      byte_order != cache_byte_order || !in.get(n_sources))
+    return false;
+  for (std::uint64_t k = 0; k != n_sources; ++k) {
+    std::string filename, filepath, digest;
+    std::uint64_t size, mtime;
+    if (!in.get(filename) || !in.get(filepath) || !in.get(size) ||
+        !in.get(mtime) || !in.get(digest))
+      return false;
+    // Each #included name must still resolve to the recorded file: the
+    // policy is called as the expansion would call it, in order.  (The
+    // top-level file's path is the cache key.)
+    if (k != 0u && !resolves_to(policy_filename, filename, filepath))
+      return false;
+    if (!unchanged(filepath, size, mtime, digest))
+      return false;
+  }
+
+  // read the includer's state:
+  std::string text;
+  std::uint64_t n_nl;
+  if (!in.get(text) || !in.get(n_nl))
+    return false;
+  std::vector<size_t> nl_positions;
+  nl_positions.reserve(n_nl);
+  for (std::uint64_t k = 0, pos; k != n_nl; ++k) {
+    if (!in.get(pos))
+      return false;
+    nl_positions.push_back(pos);
+  }
+  std::uint64_t n_frames;
+  if (!in.get(n_frames))
+    return false;
+  std::vector<frame> frames;
+  for (std::uint64_t k = 0; k != n_frames; ++k) {
+    std::uint64_t including_framenum, linenum, textpos;
+    std::string filename;
+    if (!in.get(including_framenum) || !in.get(filename) ||
+        !in.get(linenum) || !in.get(textpos))
+      return false;
+    frames.emplace_back(including_framenum, filename, linenum, textpos);
+  }
+  if (!in.done())
+    return false;
+
+  text_ = std::move(text);
+  nl_positions_ = std::move(nl_positions);
+  frames_ = std::move(frames);
+  return true;
+}
+
+void
+includer::write_cache(std::string const& cache_file) const
+{
+  std::string blob;
+  blob.reserve(text_.size() + 8u * nl_positions_.size() + 64u);
+  put(blob, cache_magic);
+  put(blob, cache_byte_order);
+  put(blob, sources_.size());
+  for (auto const& source : sources_) {
+    put(blob, source.filename);
+    put(blob, source.filepath);
+    put(blob, source.size);
+    put(blob, source.mtime);
+    put(blob, source.digest);
+  }
+  put(blob, text_);
+  put(blob, nl_positions_.size());
+  for (auto const pos : nl_positions_) {
+    put(blob, pos);
+  }
+  put(blob, frames_.size());
+  for (auto const& f : frames_) {
+    put(blob, f.including_framenum);
+    put(blob, f.filename);
+    put(blob, f.starting_linenum);
+    put(blob, f.starting_textpos);
+  }
+
+  // Write to a temporary file, then rename it, so that concurrent
+  // readers and writers see either a complete cache or none.
+  boost::system::error_code ec;
+  bfs::create_directories(bfs::path{cache_file}.parent_path(), ec);
+  std::string tmp_file{cache_file + ".XXXXXX"};
+  int const fd = ::mkstemp(&tmp_file[0]);
+  if (fd < 0)
+    return;
+  bool ok{true};
+  for (char const* p = blob.data(); ok && p != blob.data() + blob.size();) {
+    auto const n = ::write(fd, p, blob.data() + blob.size() - p);
+    if (n > 0) {
+      p += n;
+    } else if (n == 0 || errno != EINTR) {
+      ok = false;
+    }
+  }
+  ok = (::close(fd) == 0) && ok;
+  if (!ok || std::rename(tmp_file.c_str(), cache_file.c_str()) != 0) {
+    std::remove(tmp_file.c_str());
+  }
 }
 
 std::string
@@ -7,8 +7,31 @@
 //           a) transparently handles #include'd files, and
 //           b) can trace back its iterators
 //
+// The constructor taking a cache directory reuses the result of an
+// earlier expansion of the same file, stored in that directory, if
+// every file in its include closure is unchanged: same size, and the
+// same modification time or SHA-1 digest. Otherwise, it expands the
+// file and stores the result there. The cache is keyed by the filepath
+// of the top-level file, and records the filename of each #include
+// directive with the file it resolved to. Before the cache is used,
+// each filename is resolved again by the lookup policy, in the order
+// of the expansion; a different result (e.g. a new file earlier in the
+// search path) means the cache is not used. Failures to read or write
+// the cache are not errors.
+//
+// The constructor taking prefetch options reads the files #included
+// (directly or indirectly, down to the given depth) by the top-level
+// file concurrently, ahead of their expansion, on the given number of
+// threads (by default, std::thread::hardware_concurrency()). Their
+// filenames are then resolved out of order, and perhaps for files the
+// expansion never reaches, so this is done only if the lookup policy
+// is pure (see filepath_maker.h); otherwise, nothing is prefetched.
+// Filenames are resolved once each, serially; the result, including
+// any error, is identical to that of the first constructor.
+//
 // ======================================================================
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -26,11 +49,24 @@ class cet::includer {
 public:
   using const_iterator = std::string::const_iterator;
 
+  struct prefetch {
+    unsigned depth;
+    unsigned nthreads{0}; // 0: std::thread::hardware_concurrency()
+  };
+
   explicit includer(std::string const& filename,
                     cet::filepath_maker& abs_filename);
 
   explicit includer(std::istream& is, cet::filepath_maker& abs_filename);
 
+  explicit includer(std::string const& filename,
+                    cet::filepath_maker& abs_filename,
+                    std::string const& cache_dir);
+
+  explicit includer(std::string const& filename,
+                    cet::filepath_maker& abs_filename,
+                    prefetch options);
+
   const_iterator
   begin() const
   {
@@ -61,9 +97,6 @@ private:
     std::string filename;
     uint starting_linenum;
     size_t starting_textpos;
-    // The new-line positions are used to determine line numbers
-    // whenever includer::get_posinfo is called.
-    std::vector<size_t> nl_positions{};
 
     frame(uint const framenum,
           std::string const& filename,
@@ -76,6 +109,15 @@ private:
     {}
   };
 
+  // A file in the include closure, as recorded in the cache.
+  struct source_file {
+    std::string filename; // As #included, or given to the constructor.
+    std::string filepath; // As resolved by the lookup policy.
+    std::int64_t size;
+    std::int64_t mtime; // Nanoseconds since the epoch.
+    std::string digest; // SHA-1 digest of the contents.
+  };
+
   struct posinfo {
     uint textpos;  // Character position in fully-included text.
     uint linenum;  // Line number (1-based for user info).
@@ -84,15 +126,38 @@ private:
   };
 
   std::string text_{};
+  // The positions following each new-line in text_, in increasing
+  // order, used to determine line and character numbers whenever
+  // includer::get_posinfo is called.
+  std::vector<size_t> nl_positions_{};
   std::vector<frame> frames_;
   std::vector<std::string> recursionStack_{};
+  bool record_sources_{false};
+  std::vector<source_file> sources_{};
+
+  class prefetcher;
+  prefetcher* prefetcher_{nullptr}; // Only during construction.
 
   void include(int including_framenum,
                std::string const& filename,
                cet::filepath_maker& abs_filename);
 
+  void include(int including_framenum,
+               std::string const& filename,
+               std::string const& filepath,
+               cet::filepath_maker& abs_filename);
+
   void include(std::istream& is, cet::filepath_maker& abs_filename);
 
+  void include(frame new_frame,
+               char const* begin,
+               char const* end,
+               cet::filepath_maker& abs_filename);
+
+  bool read_cache(std::string const& cache_file,
+                  cet::filepath_maker& policy_filename);
+  void write_cache(std::string const& cache_file) const;
+
   std::string backtrace(uint from_frame) const;
   void debug() const;
 
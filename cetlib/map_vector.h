@@ -7,10 +7,16 @@
 // Integer subscripting is unsupported and yields a compilation failure.
 // ======================================================================
 
+#include "cetlib/detail/for_each_range.h"
+#include "cetlib/detail/map_vector_search.h"
+#include "cetlib/detail/map_vector_sort.h"
 #include "cetlib_except/exception.h"
 
 #include <algorithm>
+#include <cassert>
 #include <iosfwd>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace cet {
@@ -25,8 +31,41 @@ namespace cet {
 
   std::ostream& operator<<(std::ostream&, map_vector_key const&);
 
+  // Which of several entries with the same key bulk_insert keeps.
+  enum class map_vector_duplicates { keep_first, keep_last };
+
   template <class Value>
   class map_vector;
+
+  template <class Value>
+  struct map_vector_concatenation;
+
+  // Concatenate map_vectors, offsetting the keys of each input by the
+  // sum of the delta()s of the inputs before it.  The entries are
+  // copied, or moved from an rvalue vector of inputs, in a single pass;
+  // with nthreads other than 1 (0: the number of hardware threads),
+  // large inputs are split between threads.
+  template <class Value>
+  map_vector_concatenation<Value> concatenate(
+    map_vector<Value> const* const* inputs,
+    std::size_t n,
+    unsigned nthreads = 1);
+  template <class Value>
+  map_vector_concatenation<Value> concatenate(
+    std::vector<map_vector<Value> const*> const& inputs,
+    unsigned nthreads = 1);
+  template <class Value>
+  map_vector_concatenation<Value> concatenate(
+    std::vector<map_vector<Value>>&& inputs,
+    unsigned nthreads = 1);
+
+  namespace detail {
+    template <class Value, class Input>
+    map_vector_concatenation<Value> concatenate_map_vectors(
+      Input* const* inputs,
+      std::size_t n,
+      unsigned nthreads);
+  }
 }
 
 // ======================================================================
@@ -276,6 +315,22 @@ public:
   template <class InIter>
   void append(InIter b, InIter e);
 
+  // The bulk_insert function template inserts entries given in any
+  // order, sorting them once: building a collection of n entries this
+  // way takes O(n log n) time, rather than O(n^2) for repeated calls to
+  // operator[] or insert(value_type) with unsorted keys.  Entries with
+  // equal keys are ordered with any entry already in the collection
+  // first, followed by the incoming ones in their original order; the
+  // first of them (as for insert) or the last is kept.  With nthreads
+  // other than 1 (0: the number of hardware threads), large inputs are
+  // sorted by several threads.
+  template <class InIter>
+  void bulk_insert(
+    InIter b,
+    InIter e,
+    map_vector_duplicates keep = map_vector_duplicates::keep_first,
+    unsigned nthreads = 1);
+
   // MUST UPDATE WHEN CLASS IS CHANGED!
   static short
   Class_Version()
@@ -284,8 +339,15 @@ public:
   }
 
 private:
+  template <class V, class Input>
+  friend map_vector_concatenation<V> detail::concatenate_map_vectors(
+    Input* const*,
+    std::size_t,
+    unsigned);
+
   impl_type v_{};
 
+  size_type lower_bound(key_type key) const noexcept;
   bool class_invariant() const;
 
   static bool lt(value_type const&, value_type const&) noexcept;
@@ -293,6 +355,15 @@ private:
 
 }; // map_vector<>
 
+// ======================================================================
+
+template <class Value>
+struct cet::map_vector_concatenation {
+  map_vector<Value> combined;
+  // The offset added to the keys of each input.
+  std::vector<std::size_t> offsets;
+};
+
 // ======================================================================
 // additional map_vector_key implementation
 
@@ -372,17 +443,16 @@ template <class Value>
 bool
 cet::map_vector<Value>::has(key_type const key) const
 {
-  value_type const v{key, mapped_type{}};
-  return std::binary_search(v_.begin(), v_.end(), v, lt);
+  auto const i = lower_bound(key);
+  return i != v_.size() && v_[i].first == key;
 }
 
 template <class Value>
 typename cet::map_vector<Value>::iterator
 cet::map_vector<Value>::find(key_type const key)
 {
-  value_type const v{key, mapped_type{}};
-  auto const begin = v_.begin(), end = v_.end();
-  auto it = std::lower_bound(begin, end, v, lt);
+  auto const end = v_.end();
+  auto it = v_.begin() + lower_bound(key);
   if (it != end && it->first != key)
     it = end;
   return it;
@@ -392,9 +462,8 @@ template <class Value>
 typename cet::map_vector<Value>::const_iterator
 cet::map_vector<Value>::find(key_type const key) const
 {
-  value_type const v{key, mapped_type{}};
-  auto const begin = v_.cbegin(), end = v_.cend();
-  auto it = std::lower_bound(begin, end, v, lt);
+  auto const end = v_.cend();
+  auto it = v_.cbegin() + lower_bound(key);
   if (it != end && it->first != key)
     it = end;
   return it;
@@ -455,11 +524,10 @@ cet::map_vector<Value>::getOrThrow(key_type const key) const
 template <class Value>
 Value& cet::map_vector<Value>::operator[](key_type const key)
 {
-  value_type const v{key, mapped_type{}};
-  auto const begin = v_.begin(), end = v_.end();
-  auto it = std::lower_bound(begin, end, v, lt);
+  auto const end = v_.end();
+  auto it = v_.begin() + lower_bound(key);
   if (it == end || it->first != key)
-    it = v_.insert(it, std::move(v));
+    it = v_.insert(it, value_type{key, mapped_type{}});
   return it->second;
 }
 
@@ -471,8 +539,8 @@ std::pair<typename cet::map_vector<Value>::iterator, bool>
 cet::map_vector<Value>::insert(value_type const& v)
 {
   v.first.ensure_valid();
-  auto const begin = v_.begin(), end = v_.end();
-  auto it = std::lower_bound(begin, end, v, lt);
+  auto const end = v_.end();
+  auto it = v_.begin() + lower_bound(v.first);
   if (it == end || it->first != v.first)
     return std::make_pair(v_.insert(it, v), true);
   return std::make_pair(it, false);
@@ -503,9 +571,65 @@ cet::map_vector<Value>::append(InIter const b, InIter const e)
   assert(class_invariant());
 }
 
+template <class Value>
+template <class InIter>
+void
+cet::map_vector<Value>::bulk_insert(InIter const b,
+                                    InIter const e,
+                                    map_vector_duplicates const keep,
+                                    unsigned const nthreads)
+{
+  impl_type incoming;
+  for (auto it = b; it != e; ++it) {
+    it->first.ensure_valid();
+    incoming.push_back(*it);
+  }
+
+  std::vector<detail::map_vector_sort_entry> order;
+  order.reserve(incoming.size());
+  for (std::size_t i = 0; i != incoming.size(); ++i) {
+    order.emplace_back(incoming[i].first.asInt(), i);
+  }
+  detail::sort_map_vector_entries(order, nthreads);
+
+  // Merge the current and incoming entries.  Once an entry has been
+  // moved, nothing can throw, so *this is unchanged by an exception.
+  impl_type result;
+  result.reserve(v_.size() + incoming.size());
+  auto push = [&result, keep](value_type& v) {
+    if (result.empty() || result.back().first != v.first) {
+      result.push_back(std::move_if_noexcept(v));
+    } else if (keep == map_vector_duplicates::keep_last) {
+      result.back().second = std::move_if_noexcept(v.second);
+    }
+  };
+  auto current = v_.begin();
+  for (auto const& [key, index] : order) {
+    for (; current != v_.end() && current->first.asInt() <= key; ++current) {
+      push(*current);
+    }
+    push(incoming[index]);
+  }
+  for (; current != v_.end(); ++current) {
+    push(*current);
+  }
+  v_.swap(result);
+}
+
 // ----------------------------------------------------------------------
 // helpers:
 
+// The index of the first entry whose key is not less than key.
+template <class Value>
+typename cet::map_vector<Value>::size_type
+cet::map_vector<Value>::lower_bound(key_type const key) const noexcept
+{
+  return detail::map_vector_lower_bound(
+    v_.data(), v_.size(), key.asInt(), [](value_type const& v) {
+      return v.first.asInt();
+    });
+}
+
 template <class Value>
 bool
 cet::map_vector<Value>::class_invariant() const
@@ -513,6 +637,105 @@ cet::map_vector<Value>::class_invariant() const
   return std::is_sorted(v_.begin(), v_.end(), lt);
 }
 
+// ======================================================================
+// concatenation:
+
+template <class Value, class Input>
+cet::map_vector_concatenation<Value>
+cet::detail::concatenate_map_vectors(Input* const* const inputs,
+                                     std::size_t const n,
+                                     unsigned const max_threads)
+{
+  map_vector_concatenation<Value> result;
+  auto& offsets = result.offsets;
+  // The index in the result of the first entry of each input.
+  std::vector<std::size_t> starts;
+  offsets.reserve(n);
+  starts.reserve(n + 1);
+  std::size_t offset{}, total{};
+  for (std::size_t i = 0; i != n; ++i) {
+    offsets.push_back(offset);
+    starts.push_back(total);
+    offset += inputs[i]->delta();
+    total += inputs[i]->size();
+  }
+  starts.push_back(total);
+
+  auto mapped = [](auto& entry) -> decltype(auto) {
+    if constexpr (std::is_const_v<Input>) {
+      return (entry.second);
+    } else {
+      return std::move(entry.second);
+    }
+  };
+
+  auto& v = result.combined.v_;
+  if constexpr (std::is_default_constructible_v<Value>) {
+    // Below 1 MiB of entries per thread, a single thread is faster.
+    auto const nthreads = detail::range_threads(
+      total, max_threads, (1u << 20) / sizeof(*v.data()));
+    if (nthreads > 1) {
+      // Each thread assigns a contiguous range of the result.
+      v.resize(total);
+      detail::for_each_range(
+        total, nthreads, [&](std::size_t const b, std::size_t const e) {
+          auto i = std::upper_bound(starts.cbegin(), starts.cend(), b) -
+                   starts.cbegin() - 1;
+          for (auto j = b; j != e; ++j) {
+            while (j == starts[i + 1]) {
+              ++i;
+            }
+            auto& entry = inputs[i]->v_[j - starts[i]];
+            v[j].first = map_vector_key{entry.first.asInt() + offsets[i]};
+            v[j].second = mapped(entry);
+          }
+        });
+      return result;
+    }
+  }
+
+  v.reserve(total);
+  for (std::size_t i = 0; i != n; ++i) {
+    for (auto& entry : inputs[i]->v_) {
+      v.emplace_back(map_vector_key{entry.first.asInt() + offsets[i]},
+                     mapped(entry));
+    }
+  }
+  return result;
+}
+
+template <class Value>
+cet::map_vector_concatenation<Value>
+cet::concatenate(map_vector<Value> const* const* const inputs,
+                 std::size_t const n,
+                 unsigned const nthreads)
+{
+  return detail::concatenate_map_vectors<Value>(inputs, n, nthreads);
+}
+
+template <class Value>
+cet::map_vector_concatenation<Value>
+cet::concatenate(std::vector<map_vector<Value> const*> const& inputs,
+                 unsigned const nthreads)
+{
+  return detail::concatenate_map_vectors<Value>(
+    inputs.data(), inputs.size(), nthreads);
+}
+
+template <class Value>
+cet::map_vector_concatenation<Value>
+cet::concatenate(std::vector<map_vector<Value>>&& inputs,
+                 unsigned const nthreads)
+{
+  std::vector<map_vector<Value>*> pointers;
+  pointers.reserve(inputs.size());
+  for (auto& input : inputs) {
+    pointers.push_back(&input);
+  }
+  return detail::concatenate_map_vectors<Value>(
+    pointers.data(), pointers.size(), nthreads);
+}
+
 // ======================================================================
 
 template <class Value>
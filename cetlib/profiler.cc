@@ -0,0 +1,359 @@
+#include "cetlib/profiler.h"
+
+#include "cetlib/timer_clocks.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unistd.h>
+#include <vector>
+
+using cet::profile_node;
+using cet::profiler;
+using cet::detail::profile_buffer;
+
+// ----------------------------------------------------------------------
+// per-thread buffers
+
+namespace {
+  // Entry to a scope, or exit from the innermost one if name is null.
+  struct event {
+    char const* name;
+    cet::monotonic_clock::rep real_time;
+    cet::thread_cpu_clock::rep cpu_time;
+  };
+
+  // Events are appended to a list of fixed-size blocks.  The count of
+  // events in a block, and the link to the next block, are published
+  // with release stores, so that readers may follow the writing thread.
+  struct block {
+    static constexpr std::size_t capacity{4096};
+    event events[capacity];
+    std::atomic<std::size_t> size{0};
+    std::atomic<block*> next{nullptr};
+  };
+}
+
+struct cet::detail::profile_buffer {
+  explicit profile_buffer(unsigned const index) : thread_index{index} {}
+  ~profile_buffer() { clear(); }
+
+  // Called only by the owning thread.
+  void
+  push(event const& e) noexcept
+  {
+    auto n = tail->size.load(std::memory_order_relaxed);
+    if (n == block::capacity) {
+      auto* const b = new block;
+      tail->next.store(b, std::memory_order_release);
+      tail = b;
+      n = 0;
+    }
+    tail->events[n] = e;
+    tail->size.store(n + 1, std::memory_order_release);
+  }
+
+  // Call f for each event published so far, in order.
+  template <class F>
+  void
+  for_each(F f) const
+  {
+    for (auto const* b = &head; b != nullptr;
+         b = b->next.load(std::memory_order_acquire)) {
+      auto const n = b->size.load(std::memory_order_acquire);
+      for (std::size_t i = 0; i != n; ++i) {
+        f(b->events[i]);
+      }
+    }
+  }
+
+  // Not while the owning thread is inside a profiled scope.
+  void
+  clear() noexcept
+  {
+    auto* b = head.next.load(std::memory_order_acquire);
+    while (b != nullptr) {
+      auto* const next = b->next.load(std::memory_order_relaxed);
+      delete b;
+      b = next;
+    }
+    head.next.store(nullptr, std::memory_order_relaxed);
+    head.size.store(0, std::memory_order_release);
+    tail = &head;
+  }
+
+  unsigned const thread_index;
+  bool retired{false}; // Whether the owning thread has exited.
+  block head{};
+  block* tail{&head};
+};
+
+namespace {
+  class buffer_registry {
+  public:
+    profile_buffer*
+    add()
+    {
+      std::lock_guard sentry{mutex_};
+      return buffers_
+        .emplace_back(std::make_unique<profile_buffer>(next_index_++))
+        .get();
+    }
+
+    // Called when the owning thread exits.  A buffer without events is
+    // freed at once, the others by the next clear().
+    void
+    retire(profile_buffer* const buffer)
+    {
+      std::lock_guard sentry{mutex_};
+      if (buffer->head.size.load(std::memory_order_relaxed) == 0) {
+        erase(buffer);
+      } else {
+        buffer->retired = true;
+      }
+    }
+
+    // Call f with the buffers of all threads, in order of their first
+    // profiled scope, excluding clear() meanwhile.
+    template <class F>
+    void
+    visit(F f) const
+    {
+      std::lock_guard sentry{mutex_};
+      f(buffers_);
+    }
+
+    void
+    clear()
+    {
+      std::lock_guard sentry{mutex_};
+      buffers_.erase(std::remove_if(buffers_.begin(),
+                                    buffers_.end(),
+                                    [](auto const& buffer) {
+                                      return buffer->retired;
+                                    }),
+                     buffers_.end());
+      for (auto const& buffer : buffers_) {
+        buffer->clear();
+      }
+    }
+
+  private:
+    void
+    erase(profile_buffer const* const buffer)
+    {
+      buffers_.erase(std::find_if(
+        buffers_.begin(), buffers_.end(), [buffer](auto const& b) {
+          return b.get() == buffer;
+        }));
+    }
+
+    mutable std::mutex mutex_{};
+    std::vector<std::unique_ptr<profile_buffer>> buffers_{};
+    unsigned next_index_{};
+  };
+
+  buffer_registry&
+  registry()
+  {
+    static buffer_registry the_registry;
+    return the_registry;
+  }
+
+  // Registers the buffer of a thread at its first profiled scope, and
+  // retires it when the thread exits.
+  class buffer_owner {
+  public:
+    buffer_owner() : buffer{registry().add()} {}
+    ~buffer_owner() { registry().retire(buffer); }
+
+    buffer_owner(buffer_owner const&) = delete;
+    buffer_owner& operator=(buffer_owner const&) = delete;
+
+    profile_buffer* const buffer;
+  };
+
+  profile_buffer*
+  this_thread_buffer()
+  {
+    thread_local buffer_owner const owner;
+    return owner.buffer;
+  }
+
+  // Replay the events of one thread: on_enter(entry) is called for each
+  // entry to a scope, and returns a state kept for the scope, and
+  // on_exit(entry, state, exit) for each exit.
+  template <class OnEnter, class OnExit>
+  void
+  replay(profile_buffer const& buffer, OnEnter on_enter, OnExit on_exit)
+  {
+    using state_t = decltype(on_enter(std::declval<event const&>()));
+    std::vector<std::pair<event, state_t>> stack;
+    buffer.for_each([&](event const& e) {
+      if (e.name != nullptr) {
+        stack.emplace_back(e, on_enter(e));
+      } else if (!stack.empty()) {
+        on_exit(stack.back().first, stack.back().second, e);
+        stack.pop_back();
+      }
+    });
+  }
+
+  profile_node&
+  child(profile_node& parent, char const* const name)
+  {
+    auto const it = std::find_if(
+      parent.children.begin(), parent.children.end(), [name](auto const& n) {
+        return n.name == name;
+      });
+    if (it != parent.children.end()) {
+      return *it;
+    }
+    return parent.children.emplace_back(profile_node{name, {}, {}, {}});
+  }
+
+  void
+  write_json_string(std::ostream& os, char const* s)
+  {
+    os << '"';
+    for (; *s != '\0'; ++s) {
+      auto const c = static_cast<unsigned char>(*s);
+      if (c == '"' || c == '\\') {
+        os << '\\' << *s;
+      } else if (c < 0x20) {
+        os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+           << static_cast<unsigned>(c) << std::dec << std::setfill(' ');
+      } else {
+        os << *s;
+      }
+    }
+    os << '"';
+  }
+
+  void
+  print_node(std::ostream& os, profile_node const& node, unsigned const depth)
+  {
+    os << std::setw(10) << node.real_time.size() << std::setw(12)
+       << node.real_time.sum() << std::setw(12) << node.real_time.mean()
+       << std::setw(12) << node.cpu_time.sum() << std::setw(12)
+       << node.cpu_time.mean() << "  " << std::string(2 * depth, ' ')
+       << node.name << '\n';
+    for (auto const& child : node.children) {
+      print_node(os, child, depth + 1);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// recording
+
+profile_buffer*
+profiler::enter(char const* const name) noexcept
+{
+  auto* const buffer = this_thread_buffer();
+  auto const real_now = monotonic_clock::now();
+  buffer->push({name, real_now, thread_cpu_clock::now()});
+  return buffer;
+}
+
+void
+profiler::exit(profile_buffer* const buffer) noexcept
+{
+  // Read the cpu clock first, as enter() read it last.
+  auto const cpu_now = thread_cpu_clock::now();
+  buffer->push({nullptr, monotonic_clock::now(), cpu_now});
+}
+
+// ----------------------------------------------------------------------
+// results
+
+profile_node
+profiler::call_tree()
+{
+  profile_node root;
+  registry().visit([&root](auto const& buffers) {
+    for (auto const& buffer : buffers) {
+      // Entering a scope adds a child to the innermost node on the
+      // stack, which does not move the nodes on the stack.
+      profile_node* current = &root;
+      replay(
+        *buffer,
+        [&current](event const& entry) {
+          auto* const parent = current;
+          current = &child(*parent, entry.name);
+          return std::make_pair(current, parent);
+        },
+        [&current](event const& entry,
+                   std::pair<profile_node*, profile_node*> const nodes,
+                   event const& exit) {
+          nodes.first->real_time.sample(
+            monotonic_clock::seconds(exit.real_time - entry.real_time));
+          nodes.first->cpu_time.sample(
+            thread_cpu_clock::seconds(exit.cpu_time - entry.cpu_time));
+          current = nodes.second;
+        });
+    }
+  });
+  return root;
+}
+
+void
+profiler::write_chrome_trace(std::ostream& os)
+{
+  auto const pid = ::getpid();
+  auto const flags = os.flags();
+  os << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  registry().visit([&os, pid](auto const& buffers) {
+    // Times are in microseconds from the earliest event.
+    auto start = std::numeric_limits<monotonic_clock::rep>::max();
+    for (auto const& buffer : buffers) {
+      buffer->for_each([&start](event const& e) {
+        start = std::min(start, e.real_time);
+      });
+    }
+    char const* separator = "\n";
+    for (auto const& buffer : buffers) {
+      replay(
+        *buffer,
+        [](event const&) { return 0; },
+        [&](event const& entry, int, event const& exit) {
+          os << separator << "{\"name\":";
+          write_json_string(os, entry.name);
+          os << ",\"ph\":\"X\",\"pid\":" << pid
+             << ",\"tid\":" << buffer->thread_index
+             << ",\"ts\":" << (entry.real_time - start) * 1e-3
+             << ",\"dur\":" << (exit.real_time - entry.real_time) * 1e-3
+             << ",\"args\":{\"cpu_us\":"
+             << (exit.cpu_time - entry.cpu_time) * 1e-3 << "}}";
+          separator = ",\n";
+        });
+    }
+  });
+  os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  os.flags(flags);
+}
+
+void
+profiler::clear()
+{
+  registry().clear();
+}
+
+// ----------------------------------------------------------------------
+// free functions
+
+void
+cet::print(std::ostream& os, profile_node const& root)
+{
+  os << std::setw(10) << "Calls" << std::setw(12) << "Real (s)"
+     << std::setw(12) << "Real/call" << std::setw(12) << "CPU (s)"
+     << std::setw(12) << "CPU/call"
+     << "  Scope\n";
+  for (auto const& child : root.children) {
+    print_node(os, child, 0);
+  }
+}
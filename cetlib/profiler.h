@@ -0,0 +1,171 @@
+#ifndef cetlib_profiler_h
+#define cetlib_profiler_h
+////////////////////////////////////////////////////////////////////////
+// profiler
+//
+// A lightweight in-process profiler of nested scopes:
+//
+//   void Tracker::produce()
+//   {
+//     CET_PROFILE_SCOPE("Tracker::produce");
+//     for (auto& seed : seeds) {
+//       CET_PROFILE_SCOPE("fit");
+//       ...
+//     }
+//   }
+//
+//   cet::profiler::enable();
+//   ... run ...
+//   cet::profiler::disable();
+//   cet::print(std::cout, cet::profiler::call_tree());
+//
+// The argument of CET_PROFILE_SCOPE must be a string with static
+// storage duration, such as a literal.
+//
+// While the profiler is enabled, each scope records its entry and exit
+// times, wallclock (monotonic_clock) and cpu time of its thread
+// (thread_cpu_clock), in a buffer of its own thread.  Only that thread
+// writes to the buffer, without locks; readers see the events it has
+// published so far.  While it is disabled, a scope costs a test of a
+// global flag on entry and of a local one on exit.  Defining
+// CET_PROFILER_DISABLE before including this header compiles the
+// scopes out altogether.
+//
+// Results:
+//
+//   call_tree():          the scopes' times aggregated into a tree
+//                         merging all threads, with the distribution
+//                         of inclusive times per call of each node;
+//   print():              the call tree as text;
+//   write_chrome_trace(): each recorded scope as a complete event in the
+//                         Chrome trace-event JSON format, for viewing
+//                         in chrome://tracing or Perfetto;
+//   write_profile():      the call tree into an SQLite table (see
+//                         cetlib/write_profile.h).
+//
+// These may be called at any time, but only scopes that have exited
+// contribute.  clear() discards all recorded events, and must not be
+// called while any thread may be inside a profiled scope.
+//
+// Memory: a thread's buffer takes about 96 KiB from its first profiled
+// scope, and grows by 48 bytes per call of a scope (24 per entry and 24
+// per exit) while the profiler is enabled, without any other bound.
+// The events of a thread that has exited are kept, for the results,
+// until the next clear(), which frees its buffer; a thread that exits
+// with an empty buffer frees it at once.  Long runs should therefore
+// profile a limited span, or call clear() after reading the results.
+////////////////////////////////////////////////////////////////////////
+
+#include "cetlib/simple_stats.h"
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace cet {
+  class profiler;
+  struct profile_node;
+
+  namespace detail {
+    struct profile_buffer;
+  }
+
+  // Print the tree, one line per node, indented by depth.
+  void print(std::ostream& os, profile_node const& root);
+}
+
+// ======================================================================
+
+// A node of the call tree: the statistics of the calls of one scope
+// with one sequence of enclosing scopes.  The root node represents the
+// whole profile: it has no name or statistics of its own.
+struct cet::profile_node {
+  std::string name;
+  simple_stats real_time; // Seconds per call, including children.
+  simple_stats cpu_time;  // Seconds per call, including children.
+  std::vector<profile_node> children;
+};
+
+// ======================================================================
+
+class cet::profiler {
+  // non-instantiable:
+  profiler() = delete;
+
+public:
+  class scope;
+
+  static void
+  enable() noexcept
+  {
+    enabled_.store(true, std::memory_order_relaxed);
+  }
+  static void
+  disable() noexcept
+  {
+    enabled_.store(false, std::memory_order_relaxed);
+  }
+  static bool
+  is_enabled() noexcept
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  static profile_node call_tree();
+  static void write_chrome_trace(std::ostream& os);
+  static void clear();
+
+private:
+  static detail::profile_buffer* enter(char const* name) noexcept;
+  static void exit(detail::profile_buffer* buffer) noexcept;
+
+  static inline std::atomic<bool> enabled_{false};
+
+}; // profiler
+
+// ======================================================================
+
+class cet::profiler::scope {
+public:
+  explicit scope(char const* const name) noexcept
+  {
+    if (is_enabled()) {
+      buffer_ = enter(name);
+    }
+  }
+  ~scope() noexcept
+  {
+    if (buffer_ != nullptr) {
+      exit(buffer_);
+    }
+  }
+
+  scope(scope const&) = delete;
+  scope& operator=(scope const&) = delete;
+
+private:
+  detail::profile_buffer* buffer_{nullptr};
+};
+
+// ======================================================================
+
+#define CET_PROFILE_CONCAT_DETAIL(a, b) a##b
+#define CET_PROFILE_CONCAT(a, b) CET_PROFILE_CONCAT_DETAIL(a, b)
+
+#ifdef CET_PROFILER_DISABLE
+#define CET_PROFILE_SCOPE(name) static_cast<void>(0)
+#else
+#define CET_PROFILE_SCOPE(name)                                                \
+  ::cet::profiler::scope const CET_PROFILE_CONCAT(cet_profile_scope_,          \
+                                                  __LINE__)                    \
+  {                                                                            \
+    name                                                                       \
+  }
+#endif
+
+#endif /* cetlib_profiler_h */
+
+// Local Variables:
+// mode: c++
+// End:
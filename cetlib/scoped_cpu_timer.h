@@ -0,0 +1,124 @@
+#ifndef cetlib_scoped_cpu_timer_h
+#define cetlib_scoped_cpu_timer_h
+
+// ======================================================================
+//
+// scoped_cpu_timer: Add the wallclock and per-thread cpu times of a scope
+//                   to a total shared between threads
+//
+//   cet::cpu_time_total total; // e.g. one per module
+//   ...
+//   { // On any thread:
+//     cet::scoped_cpu_timer const timing{total};
+//     do_work();
+//   }
+//   std::cout << total.cpu_time() << " s over " << total.count()
+//             << " calls\n";
+//
+// Each scoped_cpu_timer measures the cpu time of the thread that
+// constructs it (see cpu_time_scope::thread in cpu_timer.h), so it must
+// be destroyed on the same thread, as it is when used as a local
+// variable.  The total is the sum over all threads, and may be read at
+// any time: it includes every scope that has ended.
+//
+// ======================================================================
+
+#include "cetlib/timer_clocks.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cet {
+  class cpu_time_total;
+  class scoped_cpu_timer;
+}
+
+// ======================================================================
+
+class cet::cpu_time_total {
+public:
+  cpu_time_total() = default;
+
+  // Disable copy
+  cpu_time_total(cpu_time_total const&) = delete;
+  cpu_time_total& operator=(cpu_time_total const&) = delete;
+
+  // --- accessors:
+  std::size_t
+  count() const noexcept
+  {
+    return count_.load(std::memory_order_relaxed);
+  }
+  double
+  real_time() const noexcept
+  {
+    return monotonic_clock::seconds(
+      real_ticks_.load(std::memory_order_relaxed));
+  }
+  double
+  cpu_time() const noexcept
+  {
+    return thread_cpu_clock::seconds(
+      cpu_ticks_.load(std::memory_order_relaxed));
+  }
+
+  // --- mutators:
+  void
+  add(monotonic_clock::rep const real_ticks,
+      thread_cpu_clock::rep const cpu_ticks) noexcept
+  {
+    real_ticks_.fetch_add(real_ticks, std::memory_order_relaxed);
+    cpu_ticks_.fetch_add(cpu_ticks, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void
+  reset() noexcept
+  {
+    real_ticks_.store(0, std::memory_order_relaxed);
+    cpu_ticks_.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<monotonic_clock::rep> real_ticks_{0};
+  std::atomic<thread_cpu_clock::rep> cpu_ticks_{0};
+  std::atomic<std::size_t> count_{0};
+
+}; // cpu_time_total
+
+// ======================================================================
+
+class cet::scoped_cpu_timer {
+public:
+  explicit scoped_cpu_timer(cpu_time_total& total) noexcept
+    : total_{total}
+    , start_real_time_{monotonic_clock::now()}
+    , start_cpu_time_{thread_cpu_clock::now()}
+  {}
+
+  ~scoped_cpu_timer() noexcept
+  {
+    auto const cpu_now = thread_cpu_clock::now();
+    total_.add(monotonic_clock::now() - start_real_time_,
+               cpu_now - start_cpu_time_);
+  }
+
+  // Disable copy and move
+  scoped_cpu_timer(scoped_cpu_timer const&) = delete;
+  scoped_cpu_timer& operator=(scoped_cpu_timer const&) = delete;
+
+private:
+  cpu_time_total& total_;
+  monotonic_clock::rep const start_real_time_;
+  thread_cpu_clock::rep const start_cpu_time_;
+
+}; // scoped_cpu_timer
+
+// ======================================================================
+
+#endif /* cetlib_scoped_cpu_timer_h */
+
+// Local variables:
+// mode: c++
+// End:
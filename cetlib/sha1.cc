@@ -19,6 +19,12 @@ sha1::sha1(char const mesg)
   operator<<(mesg);
 }
 
+sha1::sha1(void const* const data, std::size_t const size)
+{
+  reset();
+  update(data, size);
+}
+
 void
 sha1::reset()
 {
@@ -41,6 +47,13 @@ sha1::operator<<(char const mesg)
   return *this;
 }
 
+sha1&
+sha1::update(void const* const data, std::size_t const size)
+{
+  SHA1_Update(&context, data, size);
+  return *this;
+}
+
 sha1::digest_t
 sha1::digest()
 {
@@ -15,6 +15,7 @@
 #include <openssl/sha.h>
 #endif
 #include <array>
+#include <cstddef>
 #include <string>
 
 namespace cet {
@@ -32,11 +33,13 @@ public:
   sha1();
   explicit sha1(std::string const& mesg);
   explicit sha1(char const mesg);
+  sha1(void const* data, std::size_t size);
 
   void reset();
 
   sha1& operator<<(std::string const& mesg);
   sha1& operator<<(char const mesg);
+  sha1& update(void const* data, std::size_t size);
   digest_t digest();
 
 private:
@@ -24,6 +24,9 @@ simple_stats::simple_stats() noexcept
   , small_(+std::numeric_limits<double>::infinity())
   , sum_(0.0)
   , sumsq_(0.0)
+  , shift_(0.0)
+  , mean_(0.0)
+  , m2_(0.0)
 {
   ;
 }
@@ -35,6 +38,9 @@ simple_stats::simple_stats(double x) noexcept
   , small_(+std::numeric_limits<double>::infinity())
   , sum_(0.0)
   , sumsq_(0.0)
+  , shift_(0.0)
+  , mean_(0.0)
+  , m2_(0.0)
 {
   sample(x);
 }
@@ -45,8 +51,7 @@ simple_stats::simple_stats(double x) noexcept
 double
 simple_stats::mean() const noexcept
 {
-  return n_ == 0u ? std::numeric_limits<double>::quiet_NaN() :
-                    sum_ / double(n_);
+  return n_ == 0u ? std::numeric_limits<double>::quiet_NaN() : shift_ + mean_;
 }
 
 double
@@ -68,12 +73,7 @@ simple_stats::rms(std::size_t nparams) const noexcept
   if (n_ <= nparams)
     return std::numeric_limits<double>::quiet_NaN();
 
-  double diff = sumsq_ / double(n_) - square(mean());
-  if (diff < 0.0)
-    return 0.0;
-
-  double factor = double(n_) / double(n_ - nparams);
-  return std::sqrt(factor * diff);
+  return std::sqrt(m2_ / double(n_ - nparams));
 }
 
 double
@@ -115,6 +115,35 @@ simple_stats::sample(double x) noexcept
   small_ = std::min(std::abs(x), small_);
   sum_ += x;
   sumsq_ += square(x);
+  if (n_ == 1u)
+    shift_ = x;
+  double const dx = x - shift_;
+  double const delta = dx - mean_;
+  mean_ += delta / double(n_);
+  m2_ += delta * (dx - mean_);
+}
+
+void
+simple_stats::merge(simple_stats const& other) noexcept
+{
+  if (other.n_ == 0u)
+    return;
+  if (n_ == 0u) {
+    *this = other;
+    return;
+  }
+
+  // Chan et al.'s pairwise combination of means and squared deviations.
+  double const n = double(n_ + other.n_);
+  double const delta = (other.shift_ - shift_) + (other.mean_ - mean_);
+  mean_ += delta * (double(other.n_) / n);
+  m2_ += other.m2_ + square(delta) * (double(n_) * double(other.n_) / n);
+  n_ += other.n_;
+  min_ = std::min(other.min_, min_);
+  max_ = std::max(other.max_, max_);
+  small_ = std::min(other.small_, small_);
+  sum_ += other.sum_;
+  sumsq_ += other.sumsq_;
 }
 
 // ======================================================================
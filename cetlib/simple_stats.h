@@ -5,6 +5,13 @@
 //
 // simple_stats: yield simple statistics from individually-presented data
 //
+// The mean and the sum of squared deviations from it are updated with
+// each sample (Welford's method), working with the differences from the
+// first sample, so rms() is accurate even when the spread of the data is
+// tiny compared with their mean.  Statistics accumulated separately,
+// e.g. on different threads, can be combined with merge(); see also
+// concurrent_simple_stats.h.
+//
 // ======================================================================
 
 #include <cstddef> // size_t
@@ -73,6 +80,8 @@ public:
   // mutators:
   void reset() noexcept;
   void sample(double) noexcept;
+  // Include the samples of other, as if each had been sampled here.
+  void merge(simple_stats const& other) noexcept;
   template <class Iter>
   void
   sample(Iter begin, Iter end) noexcept
@@ -85,6 +94,8 @@ private:
   std::size_t n_;            // counter
   double min_, max_, small_; // extrema
   double sum_, sumsq_;       // accumulations
+  double shift_;             // first sample
+  double mean_, m2_;         // mean - shift_, sum of squared deviations
 
 }; // simple_stats
 
@@ -0,0 +1,733 @@
+#ifndef cetlib_soa_map_vector_h
+#define cetlib_soa_map_vector_h
+
+// ======================================================================
+// soa_map_vector: A map_vector with keys and values in separate arrays
+//
+// The interface and semantics follow cet::map_vector, but the keys are
+// kept in one contiguous vector and the mapped values in a parallel
+// one.  Lookups (find, has, getOrNull, etc.) therefore search only the
+// dense key array, which stays cache-friendly however large the mapped
+// type is.
+//
+// Dereferencing an iterator yields a pair of references,
+//
+//   std::pair<map_vector_key const&, Value&>
+//
+// so loops written for map_vector keep working:
+//
+//   for (auto const& pr : smv) { use(pr.first, pr.second); }
+//   for (auto const& [key, value] : smv) { use(key, value); }
+//   auto it = smv.find(key); it->second = value;
+//
+// Because the pair is returned by value, "auto& pr" in a range-for does
+// not compile; use "auto const&" or "auto&&" (the mapped value may
+// still be modified through either).
+//
+// The keys and values can also be accessed as whole arrays via keys()
+// and values().
+// ======================================================================
+
+#include "cetlib/detail/map_vector_search.h"
+#include "cetlib/detail/map_vector_sort.h"
+#include "cetlib/map_vector.h"
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cet {
+  template <class Value>
+  class soa_map_vector;
+
+  namespace detail {
+    template <class Value, bool Const>
+    class soa_map_vector_iterator;
+  }
+}
+
+// ======================================================================
+
+template <class Value, bool Const>
+class cet::detail::soa_map_vector_iterator {
+  using mapped_pointer = std::conditional_t<Const, Value const*, Value*>;
+  using mapped_reference = std::conditional_t<Const, Value const&, Value&>;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::pair<map_vector_key, Value>;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::pair<map_vector_key const&, mapped_reference>;
+
+  // Holds the pair of references for operator->.
+  class pointer {
+  public:
+    explicit pointer(reference const r) : r_{r} {}
+    reference const*
+    operator->() const noexcept
+    {
+      return &r_;
+    }
+
+  private:
+    reference r_;
+  };
+
+  soa_map_vector_iterator() = default;
+  soa_map_vector_iterator(map_vector_key const* const key,
+                          mapped_pointer const value) noexcept
+    : key_{key}, value_{value}
+  {}
+
+  // Conversion from iterator to const_iterator.
+  template <bool C = Const, typename = std::enable_if_t<C>>
+  soa_map_vector_iterator(
+    soa_map_vector_iterator<Value, false> const& other) noexcept
+    : key_{other.key_}, value_{other.value_}
+  {}
+
+  reference
+  operator*() const noexcept
+  {
+    return {*key_, *value_};
+  }
+  pointer
+  operator->() const noexcept
+  {
+    return pointer{**this};
+  }
+  reference
+  operator[](difference_type const n) const noexcept
+  {
+    return {key_[n], value_[n]};
+  }
+
+  soa_map_vector_iterator&
+  operator++() noexcept
+  {
+    ++key_;
+    ++value_;
+    return *this;
+  }
+  soa_map_vector_iterator
+  operator++(int) noexcept
+  {
+    auto result = *this;
+    ++*this;
+    return result;
+  }
+  soa_map_vector_iterator&
+  operator--() noexcept
+  {
+    --key_;
+    --value_;
+    return *this;
+  }
+  soa_map_vector_iterator
+  operator--(int) noexcept
+  {
+    auto result = *this;
+    --*this;
+    return result;
+  }
+
+  soa_map_vector_iterator&
+  operator+=(difference_type const n) noexcept
+  {
+    key_ += n;
+    value_ += n;
+    return *this;
+  }
+  soa_map_vector_iterator&
+  operator-=(difference_type const n) noexcept
+  {
+    return *this += -n;
+  }
+
+  friend soa_map_vector_iterator
+  operator+(soa_map_vector_iterator it, difference_type const n) noexcept
+  {
+    return it += n;
+  }
+  friend soa_map_vector_iterator
+  operator+(difference_type const n, soa_map_vector_iterator it) noexcept
+  {
+    return it += n;
+  }
+  friend soa_map_vector_iterator
+  operator-(soa_map_vector_iterator it, difference_type const n) noexcept
+  {
+    return it -= n;
+  }
+  friend difference_type
+  operator-(soa_map_vector_iterator const& a,
+            soa_map_vector_iterator const& b) noexcept
+  {
+    return a.key_ - b.key_;
+  }
+
+  friend bool
+  operator==(soa_map_vector_iterator const& a,
+             soa_map_vector_iterator const& b) noexcept
+  {
+    return a.key_ == b.key_;
+  }
+  friend bool
+  operator!=(soa_map_vector_iterator const& a,
+             soa_map_vector_iterator const& b) noexcept
+  {
+    return a.key_ != b.key_;
+  }
+  friend bool
+  operator<(soa_map_vector_iterator const& a,
+            soa_map_vector_iterator const& b) noexcept
+  {
+    return a.key_ < b.key_;
+  }
+  friend bool
+  operator>(soa_map_vector_iterator const& a,
+            soa_map_vector_iterator const& b) noexcept
+  {
+    return a.key_ > b.key_;
+  }
+  friend bool
+  operator<=(soa_map_vector_iterator const& a,
+             soa_map_vector_iterator const& b) noexcept
+  {
+    return a.key_ <= b.key_;
+  }
+  friend bool
+  operator>=(soa_map_vector_iterator const& a,
+             soa_map_vector_iterator const& b) noexcept
+  {
+    return a.key_ >= b.key_;
+  }
+
+private:
+  friend class soa_map_vector_iterator<Value, true>;
+
+  map_vector_key const* key_{nullptr};
+  mapped_pointer value_{nullptr};
+
+}; // soa_map_vector_iterator<>
+
+// ======================================================================
+
+template <class Value>
+class cet::soa_map_vector {
+public:
+  // types:
+  using key_type = map_vector_key;
+  using mapped_type = Value;
+  using value_type = std::pair<key_type, mapped_type>;
+  using keys_type = std::vector<key_type>;
+  using values_type = std::vector<mapped_type>;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using iterator = detail::soa_map_vector_iterator<Value, false>;
+  using const_iterator = detail::soa_map_vector_iterator<Value, true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  using reference = typename iterator::reference;
+  using const_reference = typename const_iterator::reference;
+
+  // c'tors:
+  soa_map_vector() = default;
+
+  template <class InIter>
+  soa_map_vector(InIter const b, InIter const e)
+  {
+    insert(b, e);
+  }
+
+  // use compiler-generated copy c'tor, copy assignment, and d'tor
+
+  // properties:
+  bool
+  empty() const noexcept
+  {
+    return keys_.empty();
+  }
+  size_type
+  size() const noexcept
+  {
+    return keys_.size();
+  }
+  size_type
+  max_size() const noexcept
+  {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+  size_type
+  capacity() const noexcept
+  {
+    return std::min(keys_.capacity(), values_.capacity());
+  }
+
+  // observers:
+  const_reference front() const;
+  const_reference back() const;
+
+  // To be used in case map_vectors must be concatenated, and not
+  // merged.
+  size_t
+  delta() const
+  {
+    return keys_.empty() ? 0 : 1 + keys_.back().asInt();
+  }
+
+  // The sorted keys, and the values in the same order.
+  keys_type const&
+  keys() const noexcept
+  {
+    return keys_;
+  }
+  values_type const&
+  values() const noexcept
+  {
+    return values_;
+  }
+  values_type&
+  values() noexcept
+  {
+    return values_;
+  }
+
+  bool has(key_type key) const;
+
+  iterator find(key_type key);
+  const_iterator find(key_type key) const;
+  const_iterator findOrThrow(key_type key) const;
+
+  mapped_type* getOrNull(key_type key);
+  mapped_type const* getOrNull(key_type key) const;
+
+  mapped_type& getOrThrow(key_type key);
+  mapped_type const& getOrThrow(key_type key) const;
+
+  mapped_type& operator[](key_type key);
+  mapped_type const& operator[](key_type key) const { return getOrThrow(key); }
+  mapped_type const&
+  at(key_type key) const
+  {
+    return getOrThrow(key);
+  }
+
+  // iterators:
+  iterator
+  begin() noexcept
+  {
+    return {keys_.data(), values_.data()};
+  }
+  const_iterator
+  begin() const noexcept
+  {
+    return {keys_.data(), values_.data()};
+  }
+
+  iterator
+  end() noexcept
+  {
+    return begin() + size();
+  }
+  const_iterator
+  end() const noexcept
+  {
+    return begin() + size();
+  }
+
+  reverse_iterator
+  rbegin() noexcept
+  {
+    return reverse_iterator{end()};
+  }
+  const_reverse_iterator
+  rbegin() const noexcept
+  {
+    return const_reverse_iterator{end()};
+  }
+
+  reverse_iterator
+  rend() noexcept
+  {
+    return reverse_iterator{begin()};
+  }
+  const_reverse_iterator
+  rend() const noexcept
+  {
+    return const_reverse_iterator{begin()};
+  }
+
+  const_iterator
+  cbegin() const noexcept
+  {
+    return begin();
+  }
+  const_iterator
+  cend() const noexcept
+  {
+    return end();
+  }
+  const_reverse_iterator
+  crbegin() const noexcept
+  {
+    return rbegin();
+  }
+  const_reverse_iterator
+  crend() const noexcept
+  {
+    return rend();
+  }
+
+  // mutators:
+  void
+  clear() noexcept
+  {
+    keys_.clear();
+    values_.clear();
+  }
+
+  void
+  reserve(size_type const n)
+  {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+
+  void
+  swap(soa_map_vector<mapped_type>& other) noexcept
+  {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+  std::pair<iterator, bool> insert(value_type const& x);
+
+  // As for map_vector: the incoming entries must be sorted, and
+  // entries whose keys are already present (or repeated in the input)
+  // are dropped.
+  template <class InIter>
+  void insert(InIter b, InIter e);
+
+  // As for map_vector: the incoming entries must be sorted, with keys
+  // disjoint from and greater than those in the current collection.
+  template <class InIter>
+  void append(InIter b, InIter e);
+
+  // As for map_vector: the incoming entries may be in any order.
+  template <class InIter>
+  void bulk_insert(
+    InIter b,
+    InIter e,
+    map_vector_duplicates keep = map_vector_duplicates::keep_first,
+    unsigned nthreads = 1);
+
+private:
+  keys_type keys_{};
+  values_type values_{};
+
+  size_type lower_bound(key_type key) const noexcept;
+  size_type index_of(key_type key) const noexcept;
+  iterator emplace_at(size_type i, key_type key, mapped_type const& value);
+
+  bool class_invariant() const;
+
+}; // soa_map_vector<>
+
+// ======================================================================
+// observers:
+
+template <class Value>
+typename cet::soa_map_vector<Value>::const_reference
+cet::soa_map_vector<Value>::front() const
+{
+  if (keys_.empty())
+    throw cet::exception("soa_map_vector::front") << "container is empty!\n";
+  return *begin();
+}
+
+template <class Value>
+typename cet::soa_map_vector<Value>::const_reference
+cet::soa_map_vector<Value>::back() const
+{
+  if (keys_.empty())
+    throw cet::exception("soa_map_vector::back") << "container is empty!\n";
+  return *(end() - 1);
+}
+
+template <class Value>
+bool
+cet::soa_map_vector<Value>::has(key_type const key) const
+{
+  return index_of(key) != size();
+}
+
+template <class Value>
+typename cet::soa_map_vector<Value>::iterator
+cet::soa_map_vector<Value>::find(key_type const key)
+{
+  return begin() + index_of(key);
+}
+
+template <class Value>
+typename cet::soa_map_vector<Value>::const_iterator
+cet::soa_map_vector<Value>::find(key_type const key) const
+{
+  return begin() + index_of(key);
+}
+
+template <class Value>
+typename cet::soa_map_vector<Value>::const_iterator
+cet::soa_map_vector<Value>::findOrThrow(key_type const key) const
+{
+  auto p = find(key);
+  if (p == cend())
+    throw cet::exception("soa_map_vector::getOrThrow")
+      << "out of range (no such key): " << key.asInt() << std::endl;
+
+  return p;
+}
+
+template <class Value>
+Value*
+cet::soa_map_vector<Value>::getOrNull(key_type const key)
+{
+  auto const i = index_of(key);
+  return i == size() ? nullptr : &values_[i];
+}
+
+template <class Value>
+Value const*
+cet::soa_map_vector<Value>::getOrNull(key_type const key) const
+{
+  auto const i = index_of(key);
+  return i == size() ? nullptr : &values_[i];
+}
+
+template <class Value>
+Value&
+cet::soa_map_vector<Value>::getOrThrow(key_type const key)
+{
+  auto* p = getOrNull(key);
+  if (p == nullptr)
+    throw cet::exception("soa_map_vector::getOrThrow")
+      << "out of range (no such key): " << key.asInt() << std::endl;
+
+  return *p;
+}
+
+template <class Value>
+Value const&
+cet::soa_map_vector<Value>::getOrThrow(key_type const key) const
+{
+  auto const* p = getOrNull(key);
+  if (p == nullptr)
+    throw cet::exception("soa_map_vector::getOrThrow")
+      << "out of range (no such key): " << key.asInt() << std::endl;
+
+  return *p;
+}
+
+template <class Value>
+Value& cet::soa_map_vector<Value>::operator[](key_type const key)
+{
+  auto const i = lower_bound(key);
+  if (i == size() || keys_[i] != key)
+    emplace_at(i, key, mapped_type{});
+  return values_[i];
+}
+
+// ----------------------------------------------------------------------
+// mutators:
+
+template <class Value>
+std::pair<typename cet::soa_map_vector<Value>::iterator, bool>
+cet::soa_map_vector<Value>::insert(value_type const& v)
+{
+  v.first.ensure_valid();
+  auto const i = lower_bound(v.first);
+  if (i == size() || keys_[i] != v.first)
+    return std::make_pair(emplace_at(i, v.first, v.second), true);
+  return std::make_pair(begin() + i, false);
+}
+
+template <class Value>
+template <class InIter>
+void
+cet::soa_map_vector<Value>::insert(InIter const b, InIter const e)
+{
+  // Copy the incoming entries first, so nothing can throw once existing
+  // values are being moved.
+  keys_type incoming_keys;
+  values_type incoming_values;
+  for (auto it = b; it != e; ++it) {
+    it->first.ensure_valid();
+    incoming_keys.push_back(it->first);
+    incoming_values.push_back(it->second);
+  }
+
+  // Call f(key, value) for each entry, existing and incoming, in key
+  // order; existing entries come before incoming ones with equal keys.
+  auto const merge = [this, &incoming_keys, &incoming_values](auto f) {
+    size_type i{};
+    for (size_type j{}; j != incoming_keys.size(); ++j) {
+      for (; i != size() && !(incoming_keys[j] < keys_[i]); ++i) {
+        f(keys_[i], values_[i]);
+      }
+      f(incoming_keys[j], incoming_values[j]);
+    }
+    for (; i != size(); ++i) {
+      f(keys_[i], values_[i]);
+    }
+  };
+
+  // Keep the first of any entries with equal keys.  The result is
+  // counted first, so that its storage is allocated before any move.
+  size_type n{};
+  key_type const* previous{nullptr};
+  merge([&n, &previous](key_type const& key, mapped_type&) {
+    if (previous == nullptr || *previous != key)
+      ++n;
+    previous = &key;
+  });
+  keys_type keys;
+  values_type values;
+  keys.reserve(n);
+  values.reserve(n);
+  merge([&keys, &values](key_type const key, mapped_type& value) {
+    if (keys.empty() || keys.back() != key) {
+      keys.push_back(key);
+      values.push_back(std::move_if_noexcept(value));
+    }
+  });
+
+  keys_.swap(keys);
+  values_.swap(values);
+}
+
+template <class Value>
+template <class InIter>
+void
+cet::soa_map_vector<Value>::append(InIter const b, InIter const e)
+{
+  std::for_each(b, e, [](auto const& pr) { return pr.first.ensure_valid(); });
+  for (auto it = b; it != e; ++it) {
+    keys_.push_back(it->first);
+    values_.push_back(it->second);
+  }
+  assert(class_invariant());
+}
+
+template <class Value>
+template <class InIter>
+void
+cet::soa_map_vector<Value>::bulk_insert(InIter const b,
+                                        InIter const e,
+                                        map_vector_duplicates const keep,
+                                        unsigned const nthreads)
+{
+  keys_type incoming_keys;
+  values_type incoming_values;
+  for (auto it = b; it != e; ++it) {
+    it->first.ensure_valid();
+    incoming_keys.push_back(it->first);
+    incoming_values.push_back(it->second);
+  }
+
+  std::vector<detail::map_vector_sort_entry> order;
+  order.reserve(incoming_keys.size());
+  for (std::size_t i = 0; i != incoming_keys.size(); ++i) {
+    order.emplace_back(incoming_keys[i].asInt(), i);
+  }
+  detail::sort_map_vector_entries(order, nthreads);
+
+  auto const n = size() + incoming_keys.size();
+  keys_type keys;
+  values_type values;
+  keys.reserve(n);
+  values.reserve(n);
+  auto push = [&keys, &values, keep](key_type const key, mapped_type& value) {
+    if (keys.empty() || keys.back() != key) {
+      keys.push_back(key);
+      values.push_back(std::move_if_noexcept(value));
+    } else if (keep == map_vector_duplicates::keep_last) {
+      values.back() = std::move_if_noexcept(value);
+    }
+  };
+  size_type i{};
+  for (auto const& [key, index] : order) {
+    for (; i != size() && keys_[i].asInt() <= key; ++i) {
+      push(keys_[i], values_[i]);
+    }
+    push(incoming_keys[index], incoming_values[index]);
+  }
+  for (; i != size(); ++i) {
+    push(keys_[i], values_[i]);
+  }
+  keys_.swap(keys);
+  values_.swap(values);
+}
+
+// ----------------------------------------------------------------------
+// helpers:
+
+// The index of the first key not less than key.
+template <class Value>
+typename cet::soa_map_vector<Value>::size_type
+cet::soa_map_vector<Value>::lower_bound(key_type const key) const noexcept
+{
+  return detail::map_vector_lower_bound(
+    keys_.data(), keys_.size(), key.asInt(), [](key_type const k) {
+      return k.asInt();
+    });
+}
+
+// The index of key, or size() if it is not present.
+template <class Value>
+typename cet::soa_map_vector<Value>::size_type
+cet::soa_map_vector<Value>::index_of(key_type const key) const noexcept
+{
+  auto const i = lower_bound(key);
+  return (i != size() && keys_[i] == key) ? i : size();
+}
+
+// Insert (key, value) at position i, leaving the container unchanged
+// if an exception is thrown.
+template <class Value>
+typename cet::soa_map_vector<Value>::iterator
+cet::soa_map_vector<Value>::emplace_at(size_type const i,
+                                       key_type const key,
+                                       mapped_type const& value)
+{
+  // Make room for the key first, so that inserting it cannot fail
+  // once the value is in place.
+  if (keys_.size() == keys_.capacity()) {
+    keys_.reserve(std::max<size_type>(1, 2 * keys_.size()));
+  }
+  values_.insert(values_.begin() + i, value);
+  keys_.insert(keys_.begin() + i, key);
+  return begin() + i;
+}
+
+template <class Value>
+bool
+cet::soa_map_vector<Value>::class_invariant() const
+{
+  return keys_.size() == values_.size() &&
+         std::is_sorted(keys_.begin(), keys_.end());
+}
+
+// ======================================================================
+#endif /* cetlib_soa_map_vector_h */
+
+// Local variables:
+// mode: c++
+// End:
@@ -0,0 +1,72 @@
+// ======================================================================
+//
+// static_plugin_registry: functions of plugins linked statically into
+//                         the program
+//
+// ======================================================================
+
+#include "cetlib/static_plugin_registry.h"
+
+#include <cstring>
+
+using cet::static_plugin_registry;
+
+namespace {
+  // Does the full libspec (e.g. "a/b/Plugin") match the requested one,
+  // which may be full or short (e.g. "Plugin")?
+  bool
+  matches(char const* full_spec, std::string const& libspec) noexcept
+  {
+    if (libspec == full_spec) {
+      return true;
+    }
+    char const* const slash = std::strrchr(full_spec, '/');
+    return slash != nullptr && libspec == slash + 1;
+  }
+}
+
+bool
+static_plugin_registry::add(entry const* begin, entry const* const end)
+{
+  auto& entries = entries_();
+  entries.insert(entries.end(), begin, end);
+  return true;
+}
+
+void*
+static_plugin_registry::find(std::string const& plugin_type,
+                             std::string const& libspec,
+                             std::string const& symbol) noexcept
+{
+  // The registry is small and consulted only when plugins are
+  // created, so a linear search suffices.
+  void* result{nullptr};
+  char const* found_spec{nullptr};
+  for (auto const& e : entries_()) {
+    if (plugin_type != e.plugin_type || symbol != e.symbol ||
+        !matches(e.libspec, libspec)) {
+      continue;
+    }
+    if (found_spec != nullptr && std::strcmp(found_spec, e.libspec) != 0) {
+      // Ambiguous short libspec: defer to the LibraryManager, which
+      // will report the problem.
+      return nullptr;
+    }
+    found_spec = e.libspec;
+    result = e.address;
+  }
+  return result;
+}
+
+bool
+static_plugin_registry::empty() noexcept
+{
+  return entries_().empty();
+}
+
+std::vector<static_plugin_registry::entry>&
+static_plugin_registry::entries_() noexcept
+{
+  static std::vector<entry> the_entries;
+  return the_entries;
+}
@@ -0,0 +1,69 @@
+#ifndef cetlib_static_plugin_registry_h
+#define cetlib_static_plugin_registry_h
+
+// ======================================================================
+//
+// static_plugin_registry: functions of plugins linked statically into
+//                         the program, consulted by cet::PluginFactory
+//                         (and hence cet::BasicPluginFactory) before
+//                         any library is searched for or loaded
+//
+// The registry is filled during static initialization by code
+// generated with the cet_static_plugin_registry() CMake function (see
+// config/StaticPluginRegistry.cmake), which also arranges for the
+// plugins' extern "C" functions to be given unique names (see
+// cetlib/PluginSymbolMacro.h). A program all of whose plugins are
+// statically registered performs no filesystem scan and no dlopen
+// when creating them.
+//
+// Each entry is registered under its full libspec (e.g. "a/b/Plugin");
+// a short libspec (e.g. "Plugin") also finds the entry, provided it is
+// unambiguous among the statically-registered plugins of the same
+// type.
+//
+// Registration (add) is not thread-safe, and must be complete before
+// find is called; lookups may be made concurrently.
+//
+// ======================================================================
+
+#include <string>
+#include <vector>
+
+namespace cet {
+  class static_plugin_registry;
+}
+
+// ----------------------------------------------------------------------
+
+class cet::static_plugin_registry {
+public:
+  struct entry {
+    char const* plugin_type; // Library type (suffix), e.g. "plugin".
+    char const* libspec;     // Full libspec, e.g. "a/b/Plugin".
+    char const* symbol;      // Unprefixed function name, e.g. "makePlugin".
+    void* address;
+  };
+
+  static_plugin_registry() = delete;
+
+  static bool add(entry const* begin, entry const* end);
+
+  // Address of the function, or nullptr if no such plugin function has
+  // been registered.
+  static void* find(std::string const& plugin_type,
+                    std::string const& libspec,
+                    std::string const& symbol) noexcept;
+
+  static bool empty() noexcept;
+
+private:
+  static std::vector<entry>& entries_() noexcept;
+};
+
+// ======================================================================
+
+#endif /* cetlib_static_plugin_registry_h */
+
+// Local Variables:
+// mode: c++
+// End:
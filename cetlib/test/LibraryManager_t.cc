@@ -5,8 +5,11 @@
 
 #include "cetlib/test/LibraryManagerTestFunc.h"
 #include "cetlib_except/exception.h"
+#include "hep_concurrency/simultaneous_function_spawner.h"
 
+#include <functional>
 #include <iterator>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -180,4 +183,68 @@ BOOST_AUTO_TEST_CASE(dictNotLoadable)
   BOOST_TEST_REQUIRE(!lm_ref.libraryIsLoadable("UnknownLibrary"));
 }
 
+BOOST_AUTO_TEST_CASE(concurrentGetSymbol)
+{
+  // Many threads race to load the same (not-yet-loaded) libraries and
+  // to look up symbols in already-loaded ones.
+  std::vector<std::string> const libspecs{
+    "1/1/2", "1/1/3", "1/2/3", "2/1/5", "5"};
+  unsigned constexpr nthreads{16u};
+  unsigned constexpr nrepeats{200u};
+  std::vector<std::vector<cettest::idString_t>> results(nthreads);
+  std::vector<std::function<void()>> tasks;
+  for (auto& result : results) {
+    tasks.push_back([this, &libspecs, &result] {
+      for (unsigned i{}; i != nrepeats; ++i) {
+        for (auto const& libspec : libspecs) {
+          result.push_back(
+            lm_ref.getSymbolByLibspec<cettest::idString_t>(libspec,
+                                                           "idString"));
+        }
+      }
+    });
+  }
+  hep::concurrency::simultaneous_function_spawner launch{tasks};
+
+  // Every thread must have obtained the same symbol for each libspec.
+  auto const& reference = results.front();
+  BOOST_TEST_REQUIRE(reference.size() == nrepeats * libspecs.size());
+  for (auto const& result : results) {
+    BOOST_TEST_REQUIRE(result == reference);
+  }
+  for (std::size_t i{}; i != libspecs.size() - 1; ++i) {
+    verify(libspecs[i], reference[i]);
+  }
+
+  // Each library is recorded as loaded exactly once.
+  std::vector<std::string> loaded;
+  lm_ref.getLoadedLibraries(loaded);
+  std::set<std::string> const unique_loaded(loaded.cbegin(), loaded.cend());
+  BOOST_TEST_REQUIRE(unique_loaded.size() == loaded.size());
+  BOOST_TEST_REQUIRE(loaded.size() == libspecs.size() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(preload)
+{
+  std::vector<std::string> const libspecs{
+    "1/1/2", "3", "2/1/5", "Unknown", "1/2/3", "5"};
+  auto const results = lm_ref.preload(libspecs, 4u);
+  BOOST_TEST_REQUIRE(results.size() == libspecs.size());
+  for (std::size_t i{}; i != results.size(); ++i) {
+    auto const& result = results[i];
+    BOOST_TEST(result.libspec == libspecs[i]);
+    if (result.libspec == "3" || result.libspec == "Unknown") {
+      // Ambiguous or non-existent library.
+      BOOST_TEST(result.lib_loc.empty());
+      BOOST_TEST(!result.error.empty());
+      continue;
+    }
+    BOOST_TEST(result.error.empty());
+    BOOST_TEST(result.load_time >= 0.);
+    BOOST_TEST(lm_ref.libraryIsLoaded(result.lib_loc));
+  }
+  // "2/1/5" and "5" refer to the same library.
+  BOOST_TEST(results[2].lib_loc == results[5].lib_loc);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
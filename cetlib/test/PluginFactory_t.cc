@@ -3,10 +3,15 @@
 
 #include "cetlib/BasicPluginFactory.h"
 #include "cetlib/PluginTypeDeducer.h"
+#include "cetlib/sqlite/ConnectionFactory.h"
+#include "cetlib/sqlite/select.h"
 #include "cetlib/test/TestPluginBase.h"
+#include "cetlib/write_plugin_load_times.h"
 #include "cetlib_except/exception.h"
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
 
 using namespace cet;
@@ -71,4 +76,52 @@ BOOST_AUTO_TEST_CASE(checkError)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(checkLoadTimes)
+{
+  using Stage = PluginLoadTimes::Stage;
+  auto count = [this](Stage const stage) {
+    auto const entries = pf.loadTimes().entries();
+    return std::count_if(
+      entries.cbegin(), entries.cend(), [stage](auto const& entry) {
+        return entry.stage == stage;
+      });
+  };
+  // The directory scan is deferred until first use, and always
+  // recorded.
+  BOOST_TEST_REQUIRE(pf.loadTimes().entries().empty());
+
+  pf.setLoadTimesEnabled(true);
+  auto p = pf.makePlugin<std::unique_ptr<cettest::TestPluginBase>, std::string>(
+    "TestPlugin", "Hi");
+  BOOST_TEST_REQUIRE(p->message() == "Hi"s);
+  BOOST_TEST(count(Stage::DirectoryScan) == 1);
+  BOOST_TEST(count(Stage::Dlopen) == 1);
+  BOOST_TEST(count(Stage::Dlsym) == 1);
+  BOOST_TEST(count(Stage::PluginCall) == 1);
+  auto const entries = pf.loadTimes().entries();
+  auto const& call = entries.back();
+  BOOST_TEST(call.library == "TestPlugin"s);
+  BOOST_TEST(call.symbol == "makePlugin"s);
+  BOOST_TEST(call.real_time >= 0.);
+  BOOST_TEST(pf.loadTimes().total_real_time(Stage::PluginCall) ==
+             call.real_time);
+
+  // Nothing more is recorded once recording is disabled.
+  pf.setLoadTimesEnabled(false);
+  pf.makePlugin<std::unique_ptr<cettest::TestPluginBase>, std::string>(
+    "TestPlugin", "Hi");
+  BOOST_TEST(pf.loadTimes().entries().size() == entries.size());
+
+  std::ostringstream os;
+  os << pf.loadTimes();
+  BOOST_TEST(os.str().find("makePlugin") != std::string::npos);
+
+  sqlite::ConnectionFactory cf;
+  std::unique_ptr<sqlite::Connection> c{cf.make_connection(":memory:")};
+  write_plugin_load_times(pf.loadTimes(), *c);
+  sqlite::query_result<int> nrows;
+  nrows << sqlite::select("count(*)").from(*c, "PluginLoadTimes");
+  BOOST_TEST(unique_value(nrows) == static_cast<int>(entries.size()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
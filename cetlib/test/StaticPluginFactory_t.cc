@@ -0,0 +1,80 @@
+#define BOOST_TEST_MODULE (StaticPluginFactory_t)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/BasicPluginFactory.h"
+#include "cetlib/PluginTypeDeducer.h"
+#include "cetlib/search_path.h"
+#include "cetlib/static_plugin_registry.h"
+#include "cetlib/test/TestPluginBase.h"
+#include "cetlib_except/exception.h"
+
+#include <memory>
+#include <new>
+#include <string>
+
+using namespace cet;
+using namespace std::string_literals;
+
+// TestPlugin is linked statically into this test, and registered under
+// the libspec "cettest/TestPlugin" by cet_static_plugin_registry(). The
+// search path is taken from an (unset) environment variable, so any
+// successful lookup must have been satisfied from the static registry.
+
+struct StaticPluginFactoryTestFixture {
+  StaticPluginFactoryTestFixture() { pf.setLoadTimesEnabled(true); }
+  BasicPluginFactory pf{
+    search_path{"STATIC_PLUGIN_FACTORY_SEARCH_PATH", std::nothrow}};
+};
+
+BOOST_FIXTURE_TEST_SUITE(StaticPluginFactory_t,
+                         StaticPluginFactoryTestFixture)
+
+BOOST_AUTO_TEST_CASE(registry)
+{
+  BOOST_TEST_REQUIRE(!static_plugin_registry::empty());
+  auto const full = static_plugin_registry::find(
+    "plugin", "cettest/TestPlugin", "makePlugin");
+  BOOST_TEST_REQUIRE(full != nullptr);
+  BOOST_TEST(static_plugin_registry::find(
+               "plugin", "TestPlugin", "makePlugin") == full);
+  BOOST_TEST(static_plugin_registry::find(
+               "service", "TestPlugin", "makePlugin") == nullptr);
+  BOOST_TEST(static_plugin_registry::find(
+               "plugin", "TestPlugin", "oops") == nullptr);
+  BOOST_TEST(static_plugin_registry::find(
+               "plugin", "estPlugin", "makePlugin") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(checkType)
+{
+  BOOST_TEST_REQUIRE(pf.pluginType("TestPlugin") ==
+                     PluginTypeDeducer_v<cettest::TestPluginBase>);
+  BOOST_TEST_REQUIRE(pf.pluginType("cettest/TestPlugin") ==
+                     PluginTypeDeducer_v<cettest::TestPluginBase>);
+}
+
+BOOST_AUTO_TEST_CASE(checkMaker)
+{
+  auto p = pf.makePlugin<std::unique_ptr<cettest::TestPluginBase>, std::string>(
+    "TestPlugin", "Hi");
+  BOOST_TEST_REQUIRE(p->message() == "Hi"s);
+}
+
+BOOST_AUTO_TEST_CASE(noScanNoLoad)
+{
+  pf.makePlugin<std::unique_ptr<cettest::TestPluginBase>, std::string>(
+    "TestPlugin", "Hi");
+  // Only the plugin call itself is recorded.
+  auto const entries = pf.loadTimes().entries();
+  BOOST_TEST_REQUIRE(entries.size() == 1ull);
+  BOOST_TEST(to_string(entries.front().stage) == "PluginCall"s);
+}
+
+BOOST_AUTO_TEST_CASE(checkError)
+{
+  BOOST_CHECK_THROW(pf.makePlugin<std::unique_ptr<cettest::TestPluginBase>>(
+                      "TestPluginX"s, "Hi"s),
+                    cet::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
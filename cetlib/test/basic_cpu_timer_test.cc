@@ -0,0 +1,155 @@
+#define BOOST_TEST_MODULE (basic_cpu_timer test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/basic_cpu_timer.h"
+#include "cetlib/timer_clocks.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace {
+  // The smallest amounts of CPU and wallclock time we can reliably
+  // measure, in seconds, allowing for preemption between two
+  // consecutive calls to the timer on a loaded machine.  As for
+  // cpu_timer.
+  double constexpr small_cputime{1.5e-3};
+  double constexpr small_realtime{1.5e-3};
+
+  // Keep the calling thread busy for dur seconds of its own CPU time.
+  double
+  busy_loop(double const dur)
+  {
+    double x = 3.14;
+    auto const start = cet::thread_cpu_clock::now();
+    do {
+      for (int i = 0; i < 1000; ++i)
+        x = std::sin(x);
+    } while (cet::thread_cpu_clock::seconds(cet::thread_cpu_clock::now() -
+                                            start) < dur);
+    return x;
+  }
+
+  template <class Timer>
+  void
+  check_sleep()
+  {
+    Timer timer;
+    BOOST_TEST(timer.realTime() == 0.0);
+    BOOST_TEST(timer.cpuTime() == 0.0);
+    timer.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    timer.stop();
+    BOOST_TEST(timer.realTime() >= 0.050);
+    BOOST_TEST(timer.realTime() < 0.5);
+    BOOST_CHECK_SMALL(timer.cpuTime(), small_cputime);
+  }
+
+  template <class Timer>
+  void
+  check_busy()
+  {
+    Timer timer;
+    timer.start();
+    std::cout << busy_loop(0.05) << '\n';
+    timer.stop();
+    double const real = timer.realTime();
+    double const cpu = timer.cpuTime();
+    BOOST_TEST(cpu >= 0.05);
+    BOOST_TEST(real >= cpu * 0.99);
+
+    // Accumulates over start/stop pairs; stop() when stopped does
+    // nothing.
+    timer.stop();
+    BOOST_TEST(timer.realTime() == real);
+    BOOST_TEST(timer.cpuTime() == cpu);
+    timer.start();
+    std::cout << busy_loop(0.02) << '\n';
+    timer.stop();
+    BOOST_TEST(timer.cpuTime() >= cpu + 0.02);
+
+    timer.reset();
+    BOOST_TEST(timer.realTime() == 0.0);
+    BOOST_TEST(timer.cpuTime() == 0.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(basic_cpu_timer_test)
+
+BOOST_AUTO_TEST_CASE(fast_cpu_timer_sleep)
+{
+  check_sleep<cet::fast_cpu_timer>();
+}
+
+BOOST_AUTO_TEST_CASE(tsc_cpu_timer_sleep)
+{
+  std::cout << "invariant TSC: " << cet::tsc_clock::is_invariant() << '\n';
+  check_sleep<cet::tsc_cpu_timer>();
+}
+
+BOOST_AUTO_TEST_CASE(fast_cpu_timer_busy)
+{
+  check_busy<cet::fast_cpu_timer>();
+}
+
+BOOST_AUTO_TEST_CASE(tsc_cpu_timer_busy)
+{
+  check_busy<cet::tsc_cpu_timer>();
+}
+
+BOOST_AUTO_TEST_CASE(null_start)
+{
+  cet::fast_cpu_timer timer;
+  timer.start();
+  BOOST_TEST(timer.is_running());
+  BOOST_CHECK_SMALL(timer.realTime(), small_realtime);
+  BOOST_CHECK_SMALL(timer.cpuTime(), small_cputime);
+  timer.stop();
+  BOOST_TEST(timer.is_stopped());
+}
+
+BOOST_AUTO_TEST_CASE(tsc_calibration)
+{
+  cet::tsc_clock::now(); // Calibrate.
+  auto const t0 = cet::monotonic_clock::now();
+  auto const c0 = cet::tsc_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto const c1 = cet::tsc_clock::now();
+  auto const t1 = cet::monotonic_clock::now();
+  double const monotonic = cet::monotonic_clock::seconds(t1 - t0);
+  double const tsc = cet::tsc_clock::seconds(c1 - c0);
+  BOOST_TEST(tsc <= monotonic * 1.001);
+  BOOST_TEST(tsc >= monotonic * 0.99 - small_realtime);
+}
+
+BOOST_AUTO_TEST_CASE(other_threads_excluded)
+{
+  // Work done by another thread while this one sleeps is not counted.
+  std::atomic<bool> stop{false};
+  std::thread worker{[&stop] {
+    double x = 3.14;
+    while (!stop.load()) {
+      x = std::sin(x);
+    }
+    std::cout << x << '\n';
+  }};
+  cet::fast_cpu_timer timer;
+  cet::basic_cpu_timer<cet::monotonic_clock, cet::process_cpu_clock>
+    process_timer;
+  timer.start();
+  process_timer.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  process_timer.stop();
+  timer.stop();
+  stop = true;
+  worker.join();
+
+  std::cout << "thread cpu: " << timer.cpuTime()
+            << " process cpu: " << process_timer.cpuTime() << '\n';
+  BOOST_CHECK_SMALL(timer.cpuTime(), small_cputime);
+  BOOST_TEST(process_timer.cpuTime() > 0.01);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
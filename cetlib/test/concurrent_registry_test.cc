@@ -0,0 +1,228 @@
+#define BOOST_TEST_MODULE (concurrent_registry test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/concurrent_registry.h"
+#include "cetlib/concurrent_registry_via_id.h"
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  unsigned constexpr n_keys{20000};
+  unsigned constexpr n_writers{4};
+  unsigned constexpr n_readers{4};
+
+  struct Value {
+    long key;
+    std::string payload;
+
+    long
+    id() const
+    {
+      return key;
+    }
+  };
+
+  // As Value, with a different key type, for a different registry.
+  struct IntValue {
+    int key;
+    std::string payload;
+
+    int
+    id() const
+    {
+      return key;
+    }
+  };
+
+  std::string
+  payload_for(long const key)
+  {
+    return "value of " + std::to_string(key);
+  }
+
+  // Run the writer function on n_writers threads, and the reader
+  // function repeatedly on n_readers threads until all writers have
+  // finished.
+  template <typename Writer, typename Reader>
+  void
+  run_concurrently(Writer writer, Reader reader)
+  {
+    std::atomic<unsigned> writers_done{0};
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i != n_readers; ++i) {
+      threads.emplace_back([&, i] {
+        std::mt19937 engine{i};
+        do {
+          reader(engine);
+        } while (writers_done.load() != n_writers);
+      });
+    }
+    for (unsigned i = 0; i != n_writers; ++i) {
+      threads.emplace_back([&, i] {
+        writer(i);
+        ++writers_done;
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  // Every writer puts every key, in its own order.
+  std::vector<long>
+  keys_for_writer(unsigned const writer)
+  {
+    std::vector<long> keys(n_keys);
+    for (unsigned i = 0; i != n_keys; ++i) {
+      keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{100 + writer});
+    return keys;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(concurrent_registry_test)
+
+BOOST_AUTO_TEST_CASE(registry_interface)
+{
+  using reg = cet::concurrent_registry<std::string, int>;
+  BOOST_TEST(reg::empty());
+  BOOST_TEST(reg::size() == 0u);
+  BOOST_TEST((reg::begin() == reg::end()));
+
+  reg::put("one", 1);
+  reg::put("two", 2);
+  reg::put("three", 3);
+  reg::put("one", 11); // Not replaced.
+  BOOST_TEST(!reg::empty());
+  BOOST_TEST(reg::size() == 3u);
+  BOOST_TEST(reg::get("one") == 1);
+  BOOST_TEST(reg::get("three") == 3);
+
+  int i{};
+  BOOST_TEST(reg::get("two", i));
+  BOOST_TEST(i == 2);
+  BOOST_TEST(!reg::get("four", i));
+  BOOST_CHECK_EXCEPTION(
+    reg::get("four"), cet::exception, [](cet::exception const& e) {
+      return e.category() == "cet::concurrent_registry";
+    });
+
+  // Iteration is in key order.
+  std::vector<std::string> keys;
+  for (auto it = reg::begin(); it != reg::end(); ++it) {
+    keys.push_back(it->first);
+  }
+  BOOST_TEST((keys == std::vector<std::string>{"one", "three", "two"}));
+}
+
+BOOST_AUTO_TEST_CASE(registry_via_id_interface)
+{
+  using reg = cet::concurrent_registry_via_id<long, Value>;
+  BOOST_TEST(reg::empty());
+  BOOST_TEST(reg::put(Value{3, "three"}) == 3);
+
+  std::vector<Value> const values{{1, "one"}, {2, "two"}};
+  reg::put(values.cbegin(), values.cend());
+  std::map<long const, Value> const m{{4, {4, "four"}}, {5, {5, "five"}}};
+  reg::put(m);
+  BOOST_TEST(reg::size() == 5u);
+  BOOST_TEST(reg::get().size() == 5u);
+  BOOST_TEST(reg::get(2).payload == "two");
+  BOOST_TEST((reg::get().find(4) != reg::cend()));
+  BOOST_TEST((reg::get().find(6) == reg::cend()));
+
+  Value v;
+  BOOST_TEST(reg::get(5, v));
+  BOOST_TEST(v.payload == "five");
+  BOOST_TEST(!reg::get(6, v));
+  BOOST_CHECK_THROW(reg::get(6), cet::exception);
+
+  long expected{1};
+  for (auto const& [key, value] : reg::get()) {
+    BOOST_TEST(key == expected++);
+    BOOST_TEST(value.id() == key);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(registry_stress)
+{
+  using reg = cet::concurrent_registry<long, std::string>;
+  std::atomic<unsigned> errors{0};
+
+  run_concurrently(
+    [](unsigned const writer) {
+      for (auto const key : keys_for_writer(writer)) {
+        reg::put(key, payload_for(key));
+      }
+    },
+    [&errors](std::mt19937& engine) {
+      std::uniform_int_distribution<long> key_dist{0, n_keys - 1};
+      std::string value;
+      for (unsigned i = 0; i != 1000; ++i) {
+        auto const key = key_dist(engine);
+        if (reg::get(key, value) && value != payload_for(key)) {
+          ++errors;
+        }
+      }
+      // Whatever is visible is complete and in order.
+      long previous{-1};
+      for (auto it = reg::begin(); it != reg::end(); ++it) {
+        if (it->first <= previous || it->second != payload_for(it->first)) {
+          ++errors;
+        }
+        previous = it->first;
+      }
+    });
+
+  BOOST_TEST(errors.load() == 0u);
+  BOOST_TEST(reg::size() == n_keys);
+  for (long key = 0; key != n_keys; ++key) {
+    BOOST_TEST_REQUIRE(reg::get(key) == payload_for(key));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(registry_via_id_stress)
+{
+  using reg = cet::concurrent_registry_via_id<int, IntValue>;
+  std::atomic<unsigned> errors{0};
+
+  run_concurrently(
+    [](unsigned const writer) {
+      std::vector<IntValue> values;
+      for (auto const key : keys_for_writer(writer)) {
+        values.push_back({static_cast<int>(key), payload_for(key)});
+        if (values.size() == 100) {
+          reg::put(values.cbegin(), values.cend());
+          values.clear();
+        }
+      }
+      reg::put(values.cbegin(), values.cend());
+    },
+    [&errors](std::mt19937& engine) {
+      std::uniform_int_distribution<int> key_dist{0, n_keys - 1};
+      for (unsigned i = 0; i != 1000; ++i) {
+        auto const key = key_dist(engine);
+        auto const it = reg::get().find(key);
+        if (it != reg::cend() && (it->second.key != key ||
+                                  it->second.payload != payload_for(key))) {
+          ++errors;
+        }
+      }
+    });
+
+  BOOST_TEST(errors.load() == 0u);
+  BOOST_TEST(reg::size() == n_keys);
+  BOOST_TEST(std::distance(reg::cbegin(), reg::cend()) ==
+             static_cast<std::ptrdiff_t>(n_keys));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
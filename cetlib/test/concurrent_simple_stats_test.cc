@@ -0,0 +1,65 @@
+#define BOOST_TEST_MODULE (concurrent_simple_stats test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/concurrent_simple_stats.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using cet::concurrent_simple_stats;
+
+BOOST_AUTO_TEST_SUITE(concurrent_simple_stats_test)
+
+BOOST_AUTO_TEST_CASE(single_thread)
+{
+  concurrent_simple_stats s{3};
+  BOOST_TEST(s.shards() == 3u);
+  BOOST_TEST(s.snapshot().size() == 0u);
+  s.sample(1.0);
+  s.sample(3.0);
+  auto const stats = s.snapshot();
+  BOOST_TEST(stats.size() == 2u);
+  BOOST_TEST(stats.mean() == 2.0);
+  BOOST_TEST(stats.min() == 1.0);
+  BOOST_TEST(stats.max() == 3.0);
+
+  s.reset();
+  BOOST_TEST(s.snapshot().size() == 0u);
+  BOOST_TEST(concurrent_simple_stats{}.shards() >= 1u);
+}
+
+BOOST_AUTO_TEST_CASE(many_threads)
+{
+  // More threads than shards, so that some share a shard.
+  unsigned constexpr nthreads{8};
+  unsigned constexpr nsamples{20000};
+  concurrent_simple_stats s{4};
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t != nthreads; ++t) {
+    threads.emplace_back([&s, t] {
+      for (unsigned i = 0; i != nsamples; ++i) {
+        s.sample(1e9 + t + (i % 2 == 0 ? -0.5 : 0.5));
+      }
+    });
+  }
+  // Reading while sampling is allowed.
+  BOOST_TEST(s.snapshot().size() <= nthreads * nsamples);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Thread t's samples are 1e9 + t +/- 0.5, so the variance is that of
+  // t (5.25) plus 0.25.
+  double constexpr n = nthreads * nsamples;
+  auto const stats = s.snapshot();
+  BOOST_TEST(stats.size() == nthreads * nsamples);
+  BOOST_TEST(stats.min() == 1e9 - 0.5);
+  BOOST_TEST(stats.max() == 1e9 + nthreads - 0.5);
+  BOOST_TEST(stats.mean() == 1e9 + 3.5, boost::test_tools::tolerance(1e-15));
+  BOOST_TEST(stats.rms() == std::sqrt(5.5 * n / (n - 1)),
+             boost::test_tools::tolerance(1e-12));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,11 +3,14 @@
 #include "boost/test/unit_test.hpp"
 
 #include "cetlib/cpu_timer.h"
+#include "cetlib/scoped_cpu_timer.h"
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include <sys/resource.h>
 
@@ -164,4 +167,64 @@ BOOST_AUTO_TEST_CASE(checkUsage)
   BOOST_TEST(timer().cpuTime() > 0.0);
 }
 
+BOOST_AUTO_TEST_CASE(threadScope)
+{
+  // Another thread's work while this one sleeps counts towards the
+  // process's cpu time, but not this thread's.
+  cet::cpu_timer process_timer;
+  cet::cpu_timer thread_timer{cet::cpu_time_scope::thread};
+  BOOST_TEST((process_timer.scope() == cet::cpu_time_scope::process));
+  BOOST_TEST((thread_timer.scope() == cet::cpu_time_scope::thread));
+
+  process_timer.start();
+  thread_timer.start();
+  std::thread worker{[] { std::cout << busy_loop(0.1) << "\n"; }};
+  worker.join();
+  thread_timer.stop();
+  process_timer.stop();
+
+  std::cout << "threadScope process cpu: " << process_timer.cpuTime()
+            << " thread cpu: " << thread_timer.cpuTime() << std::endl;
+  BOOST_TEST(process_timer.cpuTime() >= 0.1 - small_cputime);
+  BOOST_CHECK_SMALL(thread_timer.cpuTime(), small_cputime);
+  BOOST_TEST(thread_timer.realTime() >= 0.1 - small_realtime);
+}
+
+BOOST_AUTO_TEST_CASE(scopedTimer)
+{
+  // Each thread's scopes add its own cpu time to the shared total.
+  unsigned constexpr nthreads{4};
+  unsigned constexpr nscopes{5};
+  double constexpr dur{0.01};
+  cet::cpu_time_total total;
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i != nthreads; ++i) {
+    threads.emplace_back([&total] {
+      double x{};
+      for (unsigned j = 0; j != nscopes; ++j) {
+        cet::scoped_cpu_timer const timing{total};
+        cet::cpu_timer timer{cet::cpu_time_scope::thread};
+        timer.start();
+        do {
+          x += std::sin(x + j);
+        } while (timer.cpuTime() < dur);
+      }
+      std::cout << x << "\n";
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::cout << "scopedTimer cpu: " << total.cpu_time()
+            << " real: " << total.real_time() << std::endl;
+  BOOST_TEST(total.count() == nthreads * nscopes);
+  BOOST_TEST(total.cpu_time() >= nthreads * nscopes * dur);
+  BOOST_TEST(total.real_time() >= total.cpu_time() * 0.99);
+
+  total.reset();
+  BOOST_TEST(total.count() == 0u);
+  BOOST_TEST(total.cpu_time() == 0.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
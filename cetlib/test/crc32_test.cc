@@ -2,7 +2,12 @@
 
 #include "cetlib/crc32.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <random>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "CRC32Calculator.h"
 
@@ -137,3 +142,118 @@ SCENARIO("We can produce CRC32 checksums accurately")
     }
   }
 }
+
+SCENARIO("Buffer-based CRC32 checksums match the byte-at-a-time ones")
+{
+  // Random binary data, long enough to exercise every bulk
+  // implementation and all of their tail-handling paths.
+  std::mt19937 gen{20221019};
+  std::uniform_int_distribution<int> byte{0, 255};
+  std::string data(4096 + 64, '\0');
+  for (auto& c : data) {
+    c = static_cast<char>(byte(gen));
+  }
+
+  auto const bytewise = [](std::string_view const mesg) {
+    crc32 result;
+    for (char const c : mesg) {
+      result << c;
+    }
+    return result.digest();
+  };
+
+  GIVEN("Buffers of many lengths and alignments")
+  {
+    WHEN("We create CRC32 digests via the different interfaces")
+    {
+      THEN("They all agree with the reference implementation")
+      {
+        for (std::size_t offset = 0; offset != 16; ++offset) {
+          for (std::size_t length = 0; length != 300; ++length) {
+            std::string_view const mesg{data.data() + offset, length};
+            auto const ref = bytewise(mesg);
+            CHECK(crc32{mesg}.digest() == ref);
+            CHECK(crc32{mesg.data(), mesg.size()}.digest() == ref);
+            CHECK((crc32{} << mesg).digest() == ref);
+          }
+        }
+        cet::CRC32Calculator const refMaker(data);
+        CHECK(crc32{data}.digest() == refMaker.checksum());
+        CHECK(crc32{std::string_view{data}}.digest() == bytewise(data));
+      }
+    }
+  }
+
+  GIVEN("A buffer processed in pieces")
+  {
+    WHEN("We update the digest with consecutive chunks")
+    {
+      std::vector<std::size_t> const chunk_sizes{1, 15, 16, 63, 64, 65, 1000};
+      crc32 crc;
+      std::size_t pos{};
+      for (std::size_t i = 0; pos != data.size(); ++i) {
+        auto const n =
+          std::min(chunk_sizes[i % chunk_sizes.size()], data.size() - pos);
+        crc.update(data.data() + pos, n);
+        pos += n;
+      }
+
+      THEN("The result matches the digest of the whole buffer")
+      {
+        CHECK(crc.digest() == bytewise(data));
+      }
+    }
+  }
+}
+
+SCENARIO("CRC32 digests can be combined and calculated in parallel")
+{
+  // Large enough for crc32_parallel to use several chunks.
+  std::mt19937 gen{20221020};
+  std::uniform_int_distribution<int> byte{0, 255};
+  std::string data((8 << 20) + 13, '\0');
+  for (auto& c : data) {
+    c = static_cast<char>(byte(gen));
+  }
+  cet::CRC32Calculator const refMaker(data);
+  auto const ref = refMaker.checksum();
+
+  GIVEN("A message split into two parts")
+  {
+    WHEN("We combine the digests of the parts")
+    {
+      THEN("The result is the digest of the whole message")
+      {
+        std::string_view const whole{data.data(), 5000};
+        for (std::size_t split = 0; split <= whole.size(); split += 37) {
+          auto const a = whole.substr(0, split);
+          auto const b = whole.substr(split);
+          CHECK(cet::crc32_combine(
+                  crc32{a}.digest(), crc32{b}.digest(), b.size()) ==
+                crc32{whole}.digest());
+        }
+        std::string_view const all{data};
+        auto const split = all.size() / 3;
+        CHECK(cet::crc32_combine(crc32{all.substr(0, split)}.digest(),
+                                 crc32{all.substr(split)}.digest(),
+                                 all.size() - split) == ref);
+      }
+    }
+  }
+
+  GIVEN("A large buffer")
+  {
+    WHEN("We calculate its digest in parallel")
+    {
+      THEN("It matches the reference for any number of threads")
+      {
+        for (unsigned nthreads : {0u, 1u, 2u, 3u, 4u, 7u, 16u}) {
+          CHECK(cet::crc32_parallel(data, nthreads) == ref);
+        }
+        CHECK(cet::crc32_parallel("", 4) == 0);
+        CHECK(cet::crc32_parallel(TESTC, 4) ==
+              cet::CRC32Calculator{TESTC}.checksum());
+      }
+    }
+  }
+}
@@ -0,0 +1,102 @@
+// ======================================================================
+//
+// evp_digest_test
+//
+// ======================================================================
+
+#define BOOST_TEST_MODULE (evp_digest test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/MD5Digest.h"
+#include "cetlib/evp_digest.h"
+#include "cetlib/sha1.h"
+
+#include <string>
+
+using cet::digest_algorithm;
+
+namespace {
+  template <typename Digest>
+  std::string
+  hex_of(std::string const& mesg)
+  {
+    auto const hex = Digest{mesg}.hexdigest();
+    return std::string(hex.cbegin(), hex.cend());
+  }
+
+  std::string const abc{"abc"};
+}
+
+BOOST_AUTO_TEST_SUITE(evp_digest_test)
+
+BOOST_AUTO_TEST_CASE(known_digests)
+{
+  BOOST_TEST(hex_of<cet::sha1_digest>(abc) ==
+             "a9993e364706816aba3e25717850c26c9cd0d89d");
+  BOOST_TEST(
+    hex_of<cet::sha256_digest>(abc) ==
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  BOOST_TEST(
+    hex_of<cet::sha256_digest>("") ==
+    "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  if (cet::digest_available(digest_algorithm::blake2b512)) {
+    BOOST_TEST(hex_of<cet::blake2b512_digest>(abc) ==
+               "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2"
+               "d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd40"
+               "09923");
+  }
+  if (cet::digest_available(digest_algorithm::blake2s256)) {
+    BOOST_TEST(
+      hex_of<cet::blake2s256_digest>(abc) ==
+      "508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(agrees_with_sha1)
+{
+  std::string const mesg(100000, 'x');
+  BOOST_TEST(cet::sha1_digest{mesg}.digest() == cet::sha1{mesg}.digest(),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(reuse_after_digest)
+{
+  cet::sha256_digest h;
+  h << "some" << ' ' << "text";
+  auto const first = h.digest();
+  BOOST_TEST(first == cet::sha256_digest{"some text"}.digest(),
+             boost::test_tools::per_element());
+
+  // digest() resets the object.
+  h.update(abc.data(), abc.size());
+  BOOST_TEST(h.digest() == cet::sha256_digest{abc}.digest(),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(hex_into_buffer)
+{
+  char buf[2 * cet::sha1_digest::digest_sz + 1];
+  buf[sizeof buf - 1] = '#';
+  cet::sha1_digest{abc}.hexdigest(buf);
+  BOOST_TEST(std::string(buf, sizeof buf - 1) ==
+             "a9993e364706816aba3e25717850c26c9cd0d89d");
+  BOOST_TEST(buf[sizeof buf - 1] == '#');
+
+  auto const md5 = cet::MD5Digest{abc}.digest();
+  auto const md5_hex = cet::to_hex(md5.bytes);
+  BOOST_TEST(std::string(md5_hex.cbegin(), md5_hex.cend()) == md5.toString());
+}
+
+BOOST_AUTO_TEST_CASE(move)
+{
+  cet::sha1_digest a;
+  a << "ab";
+  cet::sha1_digest b{std::move(a)};
+  b << 'c';
+  cet::sha1_digest c;
+  c = std::move(b);
+  BOOST_TEST(c.digest() == cet::sha1_digest{abc}.digest(),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
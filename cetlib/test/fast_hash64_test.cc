@@ -0,0 +1,174 @@
+#include "catch2/catch.hpp"
+
+#include "cetlib/fast_hash64.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using cet::fast_hash64;
+using cet::fast_hasher64;
+
+namespace {
+  // Reference values from xxHash's XXH3_64bits_withSeed, for prefixes
+  // of the data generated by make_data(), computed with xxHash 0.8.3
+  // (as bundled by the Python xxhash 4.0.1 package).
+  std::pair<std::size_t, std::uint64_t> const unseeded[] = {
+    {0, 0x2d06800538d394c2ULL},
+    {1, 0x4c5cca45d0f4811fULL},
+    {3, 0xd079cb72d5dc8fe3ULL},
+    {4, 0x142fa07b01613ee8ULL},
+    {8, 0x9f1975fc585fd927ULL},
+    {9, 0x6bf0116fadb4b711ULL},
+    {16, 0x945d7a2e39182d35ULL},
+    {17, 0xd1539aca118a0247ULL},
+    {32, 0xe693bfc80e1097baULL},
+    {33, 0xa9bad88fefead863ULL},
+    {64, 0xbb80e57b72b853f5ULL},
+    {65, 0x6e8bfcc8e0825a34ULL},
+    {96, 0xf8670cd3f4926336ULL},
+    {97, 0xddf5917c7b3c0b0cULL},
+    {128, 0x2edf21e7a54f582cULL},
+    {129, 0x8bf7e91c7eb2f2d6ULL},
+    {240, 0x0c9860844b0ad495ULL},
+    {241, 0x246c5fe4ed1436a3ULL},
+    {256, 0x94408c78397f3c77ULL},
+    {257, 0x25d42d17a5d725c2ULL},
+    {1024, 0x0b662daec235d4caULL},
+    {1025, 0x13d178f3e2b48e9eULL},
+    {2048, 0x9fe4fe6af7adb92aULL},
+    {4097, 0xb50defd4368a0fd4ULL},
+  };
+  std::pair<std::size_t, std::uint64_t> const seeded_42[] = {
+    {0, 0xb029411ff43d84d2ULL},
+    {1, 0xc72384329881f542ULL},
+    {3, 0x4ee376736e0e4eb5ULL},
+    {4, 0xb131979393dff7c1ULL},
+    {8, 0x0d4188086aab63f0ULL},
+    {9, 0xe71161bc6f6b722fULL},
+    {16, 0x0f8ced5074463757ULL},
+    {17, 0x93865ae47e5d9d90ULL},
+    {32, 0xdae6df4756a586e0ULL},
+    {33, 0x361a0eaee7fb92b9ULL},
+    {64, 0x9095e4d18230c257ULL},
+    {65, 0x8c87fff46e9ddcd5ULL},
+    {96, 0xc4dcd2d79749023bULL},
+    {97, 0x56094decb897a7bcULL},
+    {128, 0xb729c4784e51a7e7ULL},
+    {129, 0x488fa2aa25bb4420ULL},
+    {240, 0x48da59defbac4b90ULL},
+    {241, 0xbca7d1cb6614d782ULL},
+    {256, 0x44a7d26a68e841c9ULL},
+    {257, 0xa34d359ddca2f984ULL},
+    {1024, 0x0674099fc2d618a0ULL},
+    {1025, 0x68cc779e024cdd41ULL},
+    {2048, 0x751f6860c6d949eeULL},
+    {4097, 0x585abec8fee1cb8bULL},
+  };
+
+  std::string
+  make_data()
+  {
+    std::string result(5000, '\0');
+    for (std::size_t i = 0; i != result.size(); ++i) {
+      result[i] = static_cast<char>((i * 131 + 7) % 251);
+    }
+    return result;
+  }
+
+  // Hash data in pieces of random sizes.
+  std::uint64_t
+  hash_in_pieces(std::string_view data,
+                 std::uint64_t const seed,
+                 std::mt19937& gen)
+  {
+    fast_hasher64 hasher{seed};
+    std::uniform_int_distribution<std::size_t> piece{0, 300};
+    while (!data.empty()) {
+      auto const n = std::min(piece(gen), data.size());
+      hasher.update(data.data(), n);
+      data.remove_prefix(n);
+    }
+    return hasher.digest();
+  }
+}
+
+// Short inputs can be hashed at compile time.
+static_assert(fast_hash64("") == 0x2d06800538d394c2ULL);
+static_assert(fast_hash64("abc") == 0x78af5f94892f3950ULL);
+static_assert(fast_hash64("message digest") == 0x160d8e9329be94f9ULL);
+
+SCENARIO("fast_hash64 reproduces the XXH3 64-bit hash")
+{
+  auto const data = make_data();
+
+  GIVEN("Inputs of lengths spanning all of the algorithm's size classes")
+  {
+    WHEN("We hash them in one shot")
+    {
+      THEN("The results match the reference values")
+      {
+        for (auto const& [size, expected] : unseeded) {
+          CHECK(fast_hash64(std::string_view{data.data(), size}) ==
+                expected);
+        }
+        for (auto const& [size, expected] : seeded_42) {
+          CHECK(fast_hash64(std::string_view{data.data(), size}, 42) ==
+                expected);
+        }
+      }
+    }
+
+    WHEN("We hash them in pieces")
+    {
+      std::mt19937 gen{39};
+      THEN("The results match the one-shot hashes")
+      {
+        for (auto const& [size, expected] : unseeded) {
+          CHECK(hash_in_pieces({data.data(), size}, 0, gen) == expected);
+        }
+        for (auto const& [size, expected] : seeded_42) {
+          CHECK(hash_in_pieces({data.data(), size}, 42, gen) == expected);
+        }
+        for (std::size_t size = 0; size < data.size(); size += 7) {
+          std::string_view const input{data.data(), size};
+          CHECK(hash_in_pieces(input, 0, gen) == fast_hash64(input));
+        }
+      }
+    }
+  }
+
+  GIVEN("A streaming hasher")
+  {
+    fast_hasher64 hasher;
+
+    WHEN("We take a digest part-way through")
+    {
+      hasher << std::string_view{data}.substr(0, 1000);
+      auto const partial = hasher.digest();
+      hasher << std::string_view{data}.substr(1000);
+
+      THEN("Both digests are correct")
+      {
+        CHECK(partial == fast_hash64(std::string_view{data}.substr(0, 1000)));
+        CHECK(hasher.digest() == fast_hash64(data));
+      }
+    }
+
+    WHEN("We reset it")
+    {
+      hasher << data;
+      hasher.reset();
+      hasher << "abc";
+
+      THEN("Earlier input is forgotten")
+      {
+        CHECK(hasher.digest() == fast_hash64("abc"));
+      }
+    }
+  }
+}
@@ -0,0 +1,87 @@
+// ======================================================================
+//
+// fast_hash64_test_performance: compare the speed of fast_hash64 with
+//                               std::hash and cetlib's other hashers
+//                               for keys and buffers of several sizes.
+//
+// ======================================================================
+
+#include "cetlib/MD5Digest.h"
+#include "cetlib/cpu_timer.h"
+#include "cetlib/crc32.h"
+#include "cetlib/evp_digest.h"
+#include "cetlib/fast_hash64.h"
+#include "cetlib/sha1.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace {
+  std::size_t const message_sizes[] = {8, 32, 256, 4096, 1u << 20};
+  std::size_t constexpr bytes_per_measurement{1u << 25};
+
+  // Print the time per hash (ns) and throughput (MB/s) of hash_once,
+  // which hashes one message and returns some of the result.
+  template <typename F>
+  void
+  measure(char const* name, F hash_once)
+  {
+    std::printf("%-16s", name);
+    for (auto const size : message_sizes) {
+      std::string mesg(size, '\0');
+      for (std::size_t i = 0; i != size; ++i) {
+        mesg[i] = static_cast<char>(i * 131 + 7);
+      }
+      auto const n = bytes_per_measurement / size;
+      std::uint64_t sink{};
+      cet::cpu_timer t;
+      t.start();
+      for (std::size_t i = 0; i != n; ++i) {
+        mesg[0] = static_cast<char>(i); // Defeat hoisting.
+        sink += hash_once(std::string_view{mesg});
+      }
+      t.stop();
+      auto const seconds = t.elapsed_real_time();
+      std::printf(" %7.1f/%7.0f", seconds / n * 1e9, n * size / seconds / 1e6);
+      if (sink == 1) { // Keep the results alive.
+        std::printf(" ");
+      }
+    }
+    std::printf("\n");
+  }
+}
+
+int
+main()
+{
+  std::printf("ns per hash / MB/s for message sizes (bytes):\n%-16s", "");
+  for (auto const size : message_sizes) {
+    std::printf(" %15zu", size);
+  }
+  std::printf("\n");
+
+  measure("fast_hash64",
+          [](std::string_view const mesg) { return cet::fast_hash64(mesg); });
+  measure("std::hash", [](std::string_view const mesg) {
+    return std::hash<std::string_view>{}(mesg);
+  });
+  measure("cet::crc32", [](std::string_view const mesg) {
+    return cet::crc32{mesg}.digest();
+  });
+  measure("cet::MD5Digest", [](std::string_view const mesg) {
+    return cet::MD5Digest{mesg.data(), mesg.size()}.digest().bytes[0];
+  });
+  measure("cet::sha1", [](std::string_view const mesg) {
+    return cet::sha1{mesg.data(), mesg.size()}.digest()[0];
+  });
+  measure("sha256_digest", [h = cet::sha256_digest{}](
+                             std::string_view const mesg) mutable {
+    return h.update(mesg.data(), mesg.size()).digest()[0];
+  });
+
+  return 0;
+
+} // main()
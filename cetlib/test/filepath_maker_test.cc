@@ -219,4 +219,24 @@ BOOST_AUTO_TEST_CASE(filepath_first_absolute_or_lookup_with_dot_t4)
   check_exception(maker, current_nested_dir() + "/a.txt");
 }
 
+// Only policies whose results no longer depend on earlier calls are pure.
+BOOST_AUTO_TEST_CASE(is_pure_t)
+{
+  BOOST_TEST(!cet::filepath_maker{}.is_pure());
+  BOOST_TEST(cet::filepath_lookup{path}.is_pure());
+  BOOST_TEST(cet::filepath_lookup_nonabsolute{path}.is_pure());
+
+  cet::filepath_lookup_after1 after1{path};
+  BOOST_TEST(!after1.is_pure());
+  after1(file_in_current_dir);
+  BOOST_TEST(after1.is_pure());
+  after1.reset();
+  BOOST_TEST(!after1.is_pure());
+
+  cet::filepath_first_absolute_or_lookup_with_dot with_dot{cet::getenv(path)};
+  BOOST_TEST(!with_dot.is_pure());
+  with_dot("a.txt");
+  BOOST_TEST(with_dot.is_pure());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+// ======================================================================
+//
+// hash_file_test
+//
+// ======================================================================
+
+#define BOOST_TEST_MODULE (hash_file test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/MD5Digest.h"
+#include "cetlib/crc32.h"
+#include "cetlib/hash_file.h"
+#include "cetlib/sha1.h"
+#include "cetlib_except/exception.h"
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+  std::string
+  random_contents(std::size_t const size)
+  {
+    std::mt19937 gen{size};
+    std::uniform_int_distribution<int> byte{0, 255};
+    std::string result(size, '\0');
+    for (auto& c : result) {
+      c = static_cast<char>(byte(gen));
+    }
+    return result;
+  }
+
+  std::string
+  write_file(std::string const& contents)
+  {
+    std::string const filename =
+      "hash_file_test_" + std::to_string(contents.size()) + ".dat";
+    std::ofstream{filename, std::ios::binary} << contents;
+    return filename;
+  }
+
+  // Sizes around the block sizes used for reading and mapping files.
+  std::size_t const sizes[] = {0,
+                               1,
+                               4095,
+                               4096,
+                               100000,
+                               (1u << 20) - 1,
+                               1u << 20,
+                               (1u << 20) + 1,
+                               (5u << 20) + 17};
+}
+
+BOOST_AUTO_TEST_SUITE(hash_file_test)
+
+BOOST_AUTO_TEST_CASE(hash_file_matches_in_memory_digest)
+{
+  for (auto const size : sizes) {
+    BOOST_TEST_CONTEXT("File size " << size)
+    {
+      auto const contents = random_contents(size);
+      auto const filename = write_file(contents);
+      for (bool const use_mmap : {false, true}) {
+        BOOST_TEST(cet::hash_file<cet::sha1>(filename, use_mmap) ==
+                     cet::sha1{contents}.digest(),
+                   boost::test_tools::per_element());
+        BOOST_TEST(cet::hash_file<cet::MD5Digest>(filename, use_mmap) ==
+                   cet::MD5Digest{contents}.digest());
+        BOOST_TEST(cet::hash_file<cet::crc32>(filename, use_mmap) ==
+                   cet::crc32{contents}.digest());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(hash_stream_matches_in_memory_digest)
+{
+  for (auto const size : sizes) {
+    BOOST_TEST_CONTEXT("Stream size " << size)
+    {
+      auto const contents = random_contents(size);
+      std::istringstream is{contents};
+      BOOST_TEST(cet::hash_stream<cet::MD5Digest>(is) ==
+                 cet::MD5Digest{contents}.digest());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(buffer_overloads)
+{
+  auto const contents = random_contents(1000);
+  auto const* const data = contents.data();
+  BOOST_TEST(cet::sha1(data, contents.size()).digest() ==
+               cet::sha1{contents}.digest(),
+             boost::test_tools::per_element());
+  BOOST_TEST(cet::MD5Digest(data, contents.size()).digest() ==
+             cet::MD5Digest{contents}.digest());
+
+  // Piecewise updates are equivalent to a single one.
+  cet::sha1 s;
+  s.update(data, 10).update(data + 10, contents.size() - 10);
+  BOOST_TEST(s.digest() == cet::sha1{contents}.digest(),
+             boost::test_tools::per_element());
+  cet::MD5Digest m;
+  m.update(data, 10).update(data + 10, contents.size() - 10);
+  BOOST_TEST(m.digest() == cet::MD5Digest{contents}.digest());
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+  BOOST_CHECK_THROW(cet::hash_file<cet::sha1>("no_such_file.dat"),
+                    cet::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
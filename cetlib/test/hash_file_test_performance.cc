@@ -0,0 +1,168 @@
+// ======================================================================
+//
+// hash_file_test_performance: measure the throughput of hash_file for
+//                             cet::sha1, cet::MD5Digest and cet::crc32,
+//                             checking each digest against that of the
+//                             same data hashed in memory as written, and
+//                             compare it with that of sha1sum and md5sum
+//                             where they are available.
+//
+// ======================================================================
+
+#include "cetlib/MD5Digest.h"
+#include "cetlib/cpu_timer.h"
+#include "cetlib/crc32.h"
+#include "cetlib/hash_file.h"
+#include "cetlib/nybbler.h"
+#include "cetlib/sha1.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+  std::size_t constexpr file_size{256u << 20};
+  std::string const filename{"hash_file_test_performance.dat"};
+
+  // Write the test file, returning the reference digests of its
+  // contents, hashed block by block as they are written.
+  std::tuple<cet::sha1::digest_t, cet::MD5Result, cet::crc32::digest_t>
+  write_file()
+  {
+    cet::sha1 sha1;
+    cet::MD5Digest md5;
+    cet::crc32 crc32;
+    std::vector<char> block(1u << 20);
+    std::uint32_t x{12345};
+    std::ofstream os{filename, std::ios::binary};
+    for (std::size_t written = 0; written != file_size;
+         written += block.size()) {
+      for (auto& c : block) {
+        x = x * 1664525u + 1013904223u;
+        c = static_cast<char>(x >> 24);
+      }
+      os.write(block.data(), block.size());
+      sha1.update(block.data(), block.size());
+      md5.update(block.data(), block.size());
+      crc32.update(block.data(), block.size());
+    }
+    return {sha1.digest(), md5.digest(), crc32.digest()};
+  }
+
+  void
+  report(char const* what, cet::cpu_timer const& t)
+  {
+    std::printf("%-28s %8.3fs %8.1f MB/s\n",
+                what,
+                t.elapsed_real_time(),
+                file_size / t.elapsed_real_time() / 1e6);
+  }
+
+  template <typename Hasher, typename ToHex>
+  std::string
+  time_hash_file(char const* what, bool const use_mmap, ToHex to_hex)
+  {
+    cet::cpu_timer t;
+    t.start();
+    auto const digest = cet::hash_file<Hasher>(filename, use_mmap);
+    t.stop();
+    report(what, t);
+    return to_hex(digest);
+  }
+
+  // Run an external command, returning the first word of its output
+  // (empty if the command is unavailable or fails).
+  std::string
+  time_command(char const* what, std::string const& command)
+  {
+    cet::cpu_timer t;
+    t.start();
+    FILE* const p = ::popen((command + " 2>/dev/null").c_str(), "r");
+    if (p == nullptr) {
+      std::printf("%-28s unavailable\n", what);
+      return {};
+    }
+    char buf[128]{};
+    auto const n = std::fread(buf, 1, sizeof buf - 1, p);
+    auto const status = ::pclose(p);
+    t.stop();
+    std::string output{buf, n};
+    if (status != 0 || output.empty()) {
+      std::printf("%-28s unavailable\n", what);
+      return {};
+    }
+    report(what, t);
+    return output.substr(0, output.find(' '));
+  }
+}
+
+int
+main()
+{
+  auto const [sha1_digest, md5_digest, crc32_digest] = write_file();
+
+  auto const sha1_hex = [](cet::sha1::digest_t const& d) {
+    auto result = cet::nybbler{std::string(d.cbegin(), d.cend())}.as_hex();
+    for (auto& c : result) {
+      c = std::tolower(static_cast<unsigned char>(c));
+    }
+    return result;
+  };
+  auto const md5_hex = [](cet::MD5Result const& d) { return d.toString(); };
+  auto const crc32_hex = [](cet::crc32::digest_t const d) {
+    char buf[9];
+    std::snprintf(buf, sizeof buf, "%08x", d);
+    return std::string{buf};
+  };
+
+  // Warm the page cache so all readers see the same conditions.
+  cet::hash_file<cet::crc32>(filename);
+
+  int status{};
+  auto const check = [&status](std::string const& a, std::string const& b) {
+    if (a != b) {
+      std::printf("Digest mismatch: %s != %s\n", a.c_str(), b.c_str());
+      status = 1;
+    }
+  };
+  // The external tools are optional: skip the comparison without them.
+  auto const check_tool = [&check](std::string const& a,
+                                   std::string const& b) {
+    if (!b.empty()) {
+      check(a, b);
+    }
+  };
+
+  auto const sha1_read =
+    time_hash_file<cet::sha1>("hash_file<sha1>", false, sha1_hex);
+  auto const sha1_mmap =
+    time_hash_file<cet::sha1>("hash_file<sha1> (mmap)", true, sha1_hex);
+  auto const sha1_ref = time_command("sha1sum", "sha1sum " + filename);
+  check(sha1_read, sha1_hex(sha1_digest));
+  check(sha1_mmap, sha1_hex(sha1_digest));
+  check_tool(sha1_read, sha1_ref);
+
+  auto const md5_read =
+    time_hash_file<cet::MD5Digest>("hash_file<MD5Digest>", false, md5_hex);
+  auto const md5_mmap = time_hash_file<cet::MD5Digest>(
+    "hash_file<MD5Digest> (mmap)", true, md5_hex);
+  auto const md5_ref = time_command("md5sum", "md5sum " + filename);
+  check(md5_read, md5_hex(md5_digest));
+  check(md5_mmap, md5_hex(md5_digest));
+  check_tool(md5_read, md5_ref);
+
+  auto const crc32_read =
+    time_hash_file<cet::crc32>("hash_file<crc32>", false, crc32_hex);
+  auto const crc32_mmap =
+    time_hash_file<cet::crc32>("hash_file<crc32> (mmap)", true, crc32_hex);
+  check(crc32_read, crc32_hex(crc32_digest));
+  check(crc32_mmap, crc32_hex(crc32_digest));
+
+  std::remove(filename.c_str());
+  return status;
+
+} // main()
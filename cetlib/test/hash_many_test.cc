@@ -0,0 +1,112 @@
+// ======================================================================
+//
+// hash_many_test
+//
+// ======================================================================
+
+#define BOOST_TEST_MODULE (hash_many test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/MD5Digest.h"
+#include "cetlib/crc32.h"
+#include "cetlib/evp_digest.h"
+#include "cetlib/fast_hash64.h"
+#include "cetlib/hash_many.h"
+#include "cetlib/sha1.h"
+
+#include <array>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+  // Many messages of assorted sizes, enough for several threads.
+  struct messages {
+    messages()
+    {
+      std::mt19937 gen{40};
+      std::uniform_int_distribution<std::size_t> size{0, 2000};
+      std::uniform_int_distribution<int> byte{0, 255};
+      for (std::size_t i = 0; i != 5000; ++i) {
+        std::string s(size(gen), '\0');
+        for (auto& c : s) {
+          c = static_cast<char>(byte(gen));
+        }
+        storage.push_back(std::move(s));
+      }
+      views.assign(storage.cbegin(), storage.cend());
+    }
+    std::vector<std::string> storage;
+    std::vector<std::string_view> views;
+  };
+
+  template <typename Hasher>
+  auto
+  one_at_a_time(std::vector<std::string_view> const& views)
+  {
+    cet::hash_many_result_t<Hasher> result;
+    for (auto const& view : views) {
+      result.push_back(Hasher(view.data(), view.size()).digest());
+    }
+    return result;
+  }
+
+  template <typename Hasher>
+  void
+  check_all_thread_counts(std::vector<std::string_view> const& views)
+  {
+    auto const expected = one_at_a_time<Hasher>(views);
+    for (unsigned const nthreads : {0u, 1u, 2u, 3u, 8u}) {
+      BOOST_TEST_CONTEXT("nthreads = " << nthreads)
+      {
+        BOOST_TEST((cet::hash_many<Hasher>(views, nthreads) == expected));
+      }
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(hash_many_test, messages)
+
+BOOST_AUTO_TEST_CASE(sha1)
+{
+  check_all_thread_counts<cet::sha1>(views);
+}
+
+BOOST_AUTO_TEST_CASE(md5)
+{
+  check_all_thread_counts<cet::MD5Digest>(views);
+}
+
+BOOST_AUTO_TEST_CASE(crc32)
+{
+  check_all_thread_counts<cet::crc32>(views);
+}
+
+BOOST_AUTO_TEST_CASE(sha256)
+{
+  check_all_thread_counts<cet::sha256_digest>(views);
+}
+
+BOOST_AUTO_TEST_CASE(fast_hash64)
+{
+  check_all_thread_counts<cet::fast_hasher64>(views);
+}
+
+BOOST_AUTO_TEST_CASE(other_inputs)
+{
+  BOOST_TEST(cet::hash_many<cet::sha1>(std::vector<std::string_view>{})
+               .empty());
+
+  std::array<std::string_view, 2> const pair{{"abc", ""}};
+  auto const digests = cet::hash_many<cet::crc32>(pair);
+  BOOST_TEST(digests.size() == 2u);
+  BOOST_TEST(digests[0] == cet::crc32{"abc"}.digest());
+  BOOST_TEST(digests[1] == 0u);
+
+  auto const first = cet::hash_many<cet::crc32>(pair.data(), 1);
+  BOOST_TEST(first.size() == 1u);
+  BOOST_TEST(first[0] == digests[0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,223 @@
+#define BOOST_TEST_MODULE (hashed_registry_via_id test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/fast_hash64.h"
+#include "cetlib/hashed_registry_via_id.h"
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+  struct Value {
+    long key;
+    std::string payload;
+
+    long
+    id() const
+    {
+      return key;
+    }
+  };
+
+  // A value identified by a name, to be looked up by std::string_view.
+  struct Named {
+    std::string name;
+    int number;
+
+    std::string
+    id() const
+    {
+      return name;
+    }
+  };
+
+  struct string_hash {
+    using is_transparent = void;
+
+    std::size_t
+    operator()(std::string_view const s) const noexcept
+    {
+      return cet::fast_hash64(s);
+    }
+  };
+
+  // A 16-byte digest, as used to identify parameter sets.
+  struct Digest {
+    std::array<unsigned char, 16> bytes;
+
+    bool
+    operator==(Digest const& other) const
+    {
+      return bytes == other.bytes;
+    }
+    bool
+    operator<(Digest const& other) const
+    {
+      return bytes < other.bytes;
+    }
+  };
+
+  std::ostream&
+  operator<<(std::ostream& os, Digest const& d)
+  {
+    return os << "Digest(" << static_cast<unsigned>(d.bytes[0]) << ",...)";
+  }
+
+  struct digest_hash {
+    std::size_t
+    operator()(Digest const& d) const noexcept
+    {
+      return cet::fast_hash64(
+        {reinterpret_cast<char const*>(d.bytes.data()), d.bytes.size()});
+    }
+  };
+
+  Digest
+  digest_for(unsigned const n)
+  {
+    Digest result{};
+    for (std::size_t i = 0; i != result.bytes.size(); ++i) {
+      result.bytes[i] = static_cast<unsigned char>((n * 2654435761u) >> i);
+    }
+    return result;
+  }
+
+  struct Described {
+    Digest digest;
+    unsigned n;
+
+    Digest
+    id() const
+    {
+      return digest;
+    }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(hashed_registry_via_id_test)
+
+BOOST_AUTO_TEST_CASE(interface)
+{
+  using reg = cet::hashed_registry_via_id<long, Value>;
+  BOOST_TEST(reg::empty());
+  BOOST_TEST(reg::size() == 0u);
+  BOOST_TEST((reg::begin() == reg::end()));
+  BOOST_TEST(reg::put(Value{3, "three"}) == 3);
+
+  std::vector<Value> const values{{1, "one"}, {2, "two"}, {3, "not three"}};
+  reg::put(values.cbegin(), values.cend());
+  std::map<long const, Value> const m{{5, {5, "five"}}, {4, {4, "four"}}};
+  reg::put(m);
+  BOOST_TEST(reg::size() == 5u);
+  BOOST_TEST(reg::get().size() == 5u);
+  BOOST_TEST(reg::get(3).payload == "three"); // Not replaced.
+  BOOST_TEST((reg::get().find(4) != reg::cend()));
+  BOOST_TEST(reg::get().find(4)->second.payload == "four");
+  BOOST_TEST((reg::get().find(6) == reg::cend()));
+
+  Value v;
+  BOOST_TEST(reg::get(5, v));
+  BOOST_TEST(v.payload == "five");
+  BOOST_TEST(!reg::get(6, v));
+  BOOST_CHECK_EXCEPTION(
+    reg::get(6), cet::exception, [](cet::exception const& e) {
+      return e.category() == "cet::hashed_registry_via_id";
+    });
+
+  // Iteration is in insertion order, sorted() in key order.
+  std::vector<long> inserted;
+  for (auto const& [key, value] : reg::get()) {
+    BOOST_TEST(value.id() == key);
+    inserted.push_back(key);
+  }
+  BOOST_TEST((inserted == std::vector<long>{3, 1, 2, 4, 5}));
+
+  std::vector<long> sorted;
+  for (reg::value_type const& entry : reg::sorted()) {
+    sorted.push_back(entry.first);
+  }
+  BOOST_TEST((sorted == std::vector<long>{1, 2, 3, 4, 5}));
+}
+
+BOOST_AUTO_TEST_CASE(heterogeneous_lookup)
+{
+  using reg = cet::hashed_registry_via_id<std::string, Named, string_hash>;
+  reg::put(Named{"alpha", 1});
+  reg::put(Named{"beta", 2});
+
+  std::string_view const beta{"beta"};
+  BOOST_TEST(reg::get(beta).number == 2);
+  BOOST_TEST(reg::get(std::string{"alpha"}).number == 1);
+  BOOST_TEST(reg::get("alpha").number == 1);
+  Named n;
+  BOOST_TEST(reg::get(std::string_view{"alpha"}, n));
+  BOOST_TEST(n.number == 1);
+  BOOST_TEST(!reg::get(std::string_view{"gamma"}, n));
+  BOOST_CHECK_THROW(reg::get(std::string_view{"gamma"}), cet::exception);
+}
+
+BOOST_AUTO_TEST_CASE(digest_keys)
+{
+  using reg = cet::hashed_registry_via_id<Digest, Described, digest_hash>;
+  unsigned constexpr n_values{10000};
+
+  // References stay valid as the registry grows.
+  reg::put(Described{digest_for(0), 0});
+  auto const& first = reg::get(digest_for(0));
+
+  std::vector<Described> values;
+  for (unsigned i = 1; i != n_values / 2; ++i) {
+    values.push_back({digest_for(i), i});
+  }
+  reg::put(values.cbegin(), values.cend());
+  for (unsigned i = n_values / 2; i != n_values; ++i) {
+    reg::put(Described{digest_for(i), i});
+  }
+  BOOST_TEST(reg::size() == n_values);
+  BOOST_TEST(&reg::get(digest_for(0)) == &first);
+  BOOST_TEST(first.n == 0u);
+
+  for (unsigned i = 0; i != n_values; ++i) {
+    BOOST_TEST_REQUIRE(reg::get(digest_for(i)).n == i);
+  }
+  BOOST_TEST((reg::get().find(digest_for(n_values)) == reg::cend()));
+
+  auto const sorted = reg::sorted();
+  BOOST_TEST(sorted.size() == n_values);
+  BOOST_TEST(std::is_sorted(sorted.cbegin(),
+                            sorted.cend(),
+                            [](auto const& a, auto const& b) {
+                              return a.get().first < b.get().first;
+                            }));
+  BOOST_TEST(std::distance(reg::cbegin(), reg::cend()) ==
+             static_cast<std::ptrdiff_t>(n_values));
+}
+
+BOOST_AUTO_TEST_CASE(reserve)
+{
+  using reg = cet::hashed_registry_via_id<std::string, Named>;
+  BOOST_TEST(reg::empty());
+  reg::reserve(100);
+  BOOST_TEST(reg::empty());
+  BOOST_TEST((reg::begin() == reg::end()));
+
+  std::vector<std::pair<std::string const, Named>> entries;
+  for (int i = 0; i != 100; ++i) {
+    auto const name = std::to_string(i);
+    entries.emplace_back(name, Named{name, i});
+  }
+  reg::put(entries.cbegin(), entries.cend());
+  BOOST_TEST(reg::size() == 100u);
+  BOOST_TEST(reg::get("42").number == 42);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
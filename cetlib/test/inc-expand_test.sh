@@ -59,4 +59,25 @@ STATUS=$?
 [[ ${STATUS}          ]] || exit ${STATUS}
 cmp ${FEXPECTED} ${OUTPUT_FILE} || exit 31
 
+# Trailing whitespace after a directive is ignored, as by cet::includer.
+F4=${WORKDIR}/F4.txt
+printf '#include "%s" \t\r\nthere\n' "${F1}" > ${F4}
+printf 'hello\nthere\n' > ${FEXPECTED}
+rm -rf ${OUTPUT_FILE}
+${TEST_PGM} ${F4} > ${OUTPUT_FILE}
+STATUS=$?
+[[ ${STATUS} == 0 ]] || exit 41
+cmp ${FEXPECTED} ${OUTPUT_FILE} || exit 42
+
+# Malformed directives are rejected.
+for DIRECTIVE in "#includeX \"${F1}\"" "#include \"${F1}" "#include" \
+                 "#include  \"${F1}\""; do
+  echo "${DIRECTIVE}" | ${TEST_PGM} - > ${OUTPUT_FILE}
+  [[ $? == 1 ]] || exit 51
+done
+
+# So are directives naming files that cannot be opened.
+echo "#include \"${WORKDIR}/missing.txt\"" | ${TEST_PGM} - > ${OUTPUT_FILE}
+[[ $? == 1 ]] || exit 61
+
 exit 0
@@ -1,7 +1,9 @@
 #include "cetlib/include.h"
+#include "cetlib_except/exception.h"
 #include <cstdlib>
 #include <fstream>
 #include <regex>
+#include <sstream>
 
 using cet::include;
 
@@ -27,6 +29,8 @@ namespace {
   std::string const file_i = "./i.txt";
   std::string const file_j = "./j.txt";
   std::string const file_k = "./k.txt";
+  std::string const file_l = "./l.txt";
+  std::string const file_r = "./r.txt";
 
   std::string const contents_a = "abcde\n"
                                  "vwxyz\n";
@@ -52,6 +56,10 @@ namespace {
                                  "#include \"./c.txt\"\r"
                                  "end\n";
 
+  std::string const contents_r = "begin\n"
+                                 "#include \"./r.txt\"\n"
+                                 "end\n";
+
   inline std::string
   expected_string(std::string const& str)
   {
@@ -73,6 +81,38 @@ namespace {
     j << contents_j;
     std::ofstream k(file_k);
     k << contents_k;
+    std::ofstream r(file_r);
+    r << contents_r;
+  }
+
+  // A file larger than the block size used by the streaming variants,
+  // with line terminators (including "\r\n") and #include directives
+  // straddling block boundaries; and its expected expansion.
+  std::string
+  write_large_file()
+  {
+    std::ofstream l(file_l);
+    std::string expected;
+    for (int n = 0; n != 50000; ++n) {
+      switch (n % 4) {
+      case 0:
+        l << "line " << n << "\r\n";
+        break;
+      case 1:
+        l << "line " << n << '\r';
+        break;
+      case 2:
+        l << "line " << n << '\n';
+        break;
+      default:
+        l << "#include \"./a.txt\"\r\n";
+        expected += expected_string(contents_a);
+        continue;
+      }
+      expected += "line " + std::to_string(n) + '\n';
+    }
+    l << "unterminated";
+    return expected + "unterminated\n";
   }
 }
 
@@ -137,4 +177,47 @@ main()
                        expected_string(contents_c) + expected_string("end\n"));
   }
 
+  {
+    std::string result;
+    std::ifstream k(file_k);
+    ensure(41, k);
+    include(k, result);
+    std::ifstream k2(file_k);
+    std::ostringstream os;
+    include(k2, os);
+    ensure(42, os.str() == result);
+  }
+
+  {
+    std::string const expected = write_large_file();
+    std::ifstream l(file_l);
+    ensure(51, l);
+    std::ostringstream os;
+    include(l, os);
+    ensure(52, os.str() == expected);
+
+    std::ifstream l2(file_l);
+    std::string result;
+    unsigned calls{};
+    include(l2, [&result, &calls](char const* data, std::size_t n) {
+      result.append(data, n);
+      ++calls;
+    });
+    ensure(53, result == expected);
+    ensure(54, calls > 1u);
+  }
+
+  {
+    std::ifstream r(file_r);
+    ensure(61, r);
+    std::string result;
+    try {
+      include(r, result);
+      ensure(62, false);
+    }
+    catch (cet::exception const& e) {
+      ensure(63, e.category() == "Recursive #include directive:");
+    }
+  }
+
 } // main()
@@ -17,6 +17,9 @@
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace {
@@ -27,6 +30,8 @@ namespace {
   std::string const file_i = "./i.txt";
   std::string const file_j = "./j.txt";
   std::string const file_k = "./k.txt";
+  std::string const file_l = "./l.txt";
+  std::string const file_m = "./m.txt";
   std::string const file_r = "./r.txt";
   std::string const file_r2 = "./r2.txt";
   std::string const file_r3 = "./r3.txt";
@@ -59,6 +64,16 @@ namespace {
                                  "#include \"./i.txt\"\n"
                                  "end\n";
 
+  std::string const contents_l = "begin\n"
+                                 "#include \"./a.txt\"\n"
+                                 "middle\r\n"
+                                 "end";
+
+  std::string const contents_m = "begin\n"
+                                 "#include \"./a.txt\"\n"
+                                 "#include \"./missing.txt\"\n"
+                                 "end\n";
+
   std::string const contents_r = "begin\n"
                                  "#include \"./r.txt\"\n"
                                  "end\n";
@@ -101,6 +116,10 @@ namespace {
     j << contents_j;
     std::ofstream k(file_k);
     k << contents_k;
+    std::ofstream l(file_l);
+    l << contents_l;
+    std::ofstream m(file_m);
+    m << contents_m;
     std::ofstream r(file_r);
     r << contents_r;
     std::ofstream r2(file_r2);
@@ -121,6 +140,20 @@ namespace {
   }
 
   cet::filepath_lookup policy{".:./test"};
+
+  // Counts the lookups made. An includer using its cache resolves the
+  // filename of each file of the include closure once; one that
+  // expands its file resolves those it reads again.
+  class counting_policy : public cet::filepath_maker {
+  public:
+    std::string
+    operator()(std::string const& filename) override
+    {
+      ++count;
+      return filename;
+    }
+    unsigned count{};
+  };
 }
 
 BOOST_AUTO_TEST_SUITE(includer_test)
@@ -268,4 +301,162 @@ BOOST_AUTO_TEST_CASE(highlighted_backtrace_test)
   BOOST_TEST_REQUIRE(j.highlighted_whereis(it) == cmp);
 }
 
+BOOST_AUTO_TEST_CASE(resumed_line_numbers_test)
+{
+  cet::includer l(file_l, policy);
+  std::string result(l.begin(), l.end());
+  BOOST_TEST(result == expected_string("begin\n") +
+                         expected_string(contents_a) +
+                         expected_string("middle\nend\n"));
+  auto it = l.begin();
+  std::advance(it, result.find("end"));
+  std::string const cmp("line 4, character 1, of file \"././l.txt\"");
+  BOOST_TEST_REQUIRE(l.whereis(it) == cmp);
+}
+
+BOOST_AUTO_TEST_CASE(prefetch_test)
+{
+  // The expansion, or the error message.
+  auto const expand = [](auto make_includer) {
+    try {
+      auto const inc = make_includer();
+      std::string result{inc.begin(), inc.end()};
+      for (auto it = inc.begin(); it != inc.end(); ++it) {
+        result += inc.whereis(it);
+      }
+      return result;
+    }
+    catch (cet::exception const& e) {
+      return std::string{e.what()};
+    }
+  };
+
+  for (auto const& file : {file_a,
+                           file_c,
+                           file_j,
+                           file_k,
+                           file_l,
+                           file_m,
+                           file_r,
+                           file_r2,
+                           file_x1,
+                           file_x3,
+                           std::string{"./missing.txt"}}) {
+    for (unsigned const depth : {0u, 1u, 5u}) {
+      BOOST_TEST(expand([&file] {
+                   return cet::includer{file, policy};
+                 }) == expand([&file, depth] {
+                   return cet::includer{
+                     file, policy, cet::includer::prefetch{depth, 4}};
+                 }),
+                 file << " with prefetch depth " << depth);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(prefetch_stateful_policy_test)
+{
+  // A policy that is not pure sees the same calls, in the same order,
+  // as without prefetching.
+  class recording_policy : public cet::filepath_lookup {
+  public:
+    using filepath_lookup::filepath_lookup;
+    std::string
+    operator()(std::string const& filename) override
+    {
+      calls.push_back(filename);
+      return filepath_lookup::operator()(filename);
+    }
+    bool
+    is_pure() const noexcept override
+    {
+      return false;
+    }
+    std::vector<std::string> calls;
+  };
+
+  for (auto const& file : {file_j, file_k, file_l}) {
+    recording_policy serial{".:./test"};
+    cet::includer const inc1{file, serial};
+    recording_policy prefetching{".:./test"};
+    cet::includer const inc2{
+      file, prefetching, cet::includer::prefetch{5, 4}};
+    BOOST_TEST(prefetching.calls == serial.calls);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cache_test)
+{
+  std::string const cache_dir{"./includer_cache"};
+  std::string const file_top{"./cached.txt"};
+  std::string const file_inc{"./cached_inc.txt"};
+  std::ofstream{file_top} << "begin\n"
+                             "#include \"./cached_inc.txt\"\n"
+                             "middle\n"
+                             "end\n";
+  std::ofstream{file_inc} << "x\n";
+
+  cet::filepath_maker plain;
+  cet::includer const reference{file_top, plain};
+  auto const where = [](cet::includer const& inc) {
+    std::string result;
+    for (auto it = inc.begin(); it != inc.end(); ++it) {
+      result += inc.src_whereis(it) + '\n';
+    }
+    return result;
+  };
+
+  // First use: expanded, and stored in the cache.
+  counting_policy p1;
+  cet::includer const inc1{file_top, p1, cache_dir};
+  BOOST_TEST(p1.count == 2u);
+  BOOST_TEST(std::string(inc1.begin(), inc1.end()) ==
+             std::string(reference.begin(), reference.end()));
+
+  // Second use: read from the cache.
+  counting_policy p2;
+  cet::includer const inc2{file_top, p2, cache_dir};
+  BOOST_TEST(p2.count == 2u);
+  BOOST_TEST(std::string(inc2.begin(), inc2.end()) ==
+             "begin\nx\nmiddle\nend\n");
+  BOOST_TEST(where(inc2) == where(reference));
+  BOOST_TEST(inc2.highlighted_whereis(inc2.begin() + 7) ==
+             reference.highlighted_whereis(reference.begin() + 7));
+
+  // Same contents, different modification time: still valid.
+  timespec const times[2]{{0, UTIME_OMIT}, {1000000, 0}};
+  BOOST_TEST_REQUIRE(utimensat(AT_FDCWD, file_inc.c_str(), times, 0) == 0);
+  counting_policy p3;
+  cet::includer const inc3{file_top, p3, cache_dir};
+  BOOST_TEST(p3.count == 2u);
+
+  // Changed contents: expanded again.
+  std::ofstream{file_inc} << "yy\n";
+  counting_policy p4;
+  cet::includer const inc4{file_top, p4, cache_dir};
+  BOOST_TEST(p4.count == 3u);
+  BOOST_TEST(std::string(inc4.begin(), inc4.end()) ==
+             "begin\nyy\nmiddle\nend\n");
+}
+
+BOOST_AUTO_TEST_CASE(cache_shadowing_test)
+{
+  // A file appearing earlier in the search path, shadowing an #included
+  // one, means the cache is not used.
+  std::string const cache_dir{"./includer_cache"};
+  ::mkdir("./shadow_first", 0777);
+  ::mkdir("./shadow_second", 0777);
+  std::ofstream{"./shadow_second/shadow_top.txt"}
+    << "#include \"shadow_inc.txt\"\n";
+  std::ofstream{"./shadow_second/shadow_inc.txt"} << "second\n";
+  cet::filepath_lookup lookup{"./shadow_first:./shadow_second"};
+
+  cet::includer const inc1{"shadow_top.txt", lookup, cache_dir};
+  BOOST_TEST(std::string(inc1.begin(), inc1.end()) == "second\n");
+
+  std::ofstream{"./shadow_first/shadow_inc.txt"} << "first\n";
+  cet::includer const inc2{"shadow_top.txt", lookup, cache_dir};
+  BOOST_TEST(std::string(inc2.begin(), inc2.end()) == "first\n");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+// ======================================================================
+//
+// includer_test_performance: time the construction of an includer for
+//                            a 100,000-line include tree, and position
+//                            lookups (src_whereis) for every line.
+//
+// ======================================================================
+
+#include "cetlib/cpu_timer.h"
+#include "cetlib/filepath_maker.h"
+#include "cetlib/includer.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+  unsigned constexpr n_mid{10};
+  unsigned constexpr n_leaf{10};
+  unsigned constexpr n_lines{1000};
+
+  std::string
+  leaf_name(unsigned const i, unsigned const j)
+  {
+    return "leaf_" + std::to_string(i) + '_' + std::to_string(j) + ".txt";
+  }
+
+  std::string
+  mid_name(unsigned const i)
+  {
+    return "mid_" + std::to_string(i) + ".txt";
+  }
+
+  // top.txt includes n_mid files, each of which includes n_leaf files
+  // of n_lines lines. Every tenth line of a leaf file is an #include of
+  // a one-line file, giving many frames.
+  void
+  write_files()
+  {
+    std::ofstream{"common.txt"} << "common: { value: 0 }\n";
+    std::ofstream top{"top.txt"};
+    for (unsigned i = 0; i != n_mid; ++i) {
+      top << "#include \"" << mid_name(i) << "\"\n";
+      std::ofstream mid{mid_name(i)};
+      for (unsigned j = 0; j != n_leaf; ++j) {
+        mid << "#include \"" << leaf_name(i, j) << "\"\n";
+        std::ofstream leaf{leaf_name(i, j)};
+        for (unsigned k = 0; k != n_lines; ++k) {
+          if (k % 10 == 0) {
+            leaf << "#include \"common.txt\"\n";
+            continue;
+          }
+          leaf << "parameter_" << k << ": { value: " << k
+               << " label: \"some string value\" }\n";
+        }
+      }
+    }
+  }
+}
+
+int
+main()
+{
+  write_files();
+
+  cet::filepath_maker policy;
+  cet::cpu_timer t;
+
+  t.start();
+  cet::includer const inc{"top.txt", policy};
+  t.stop();
+  std::printf("includer: %gs to include %u lines\n",
+              t.elapsed_real_time(),
+              n_mid * n_leaf * n_lines);
+
+  // The start of every line.
+  std::vector<cet::includer::const_iterator> line_starts;
+  line_starts.push_back(inc.begin());
+  for (auto it = inc.begin(); it != inc.end(); ++it) {
+    if (*it == '\n' && it + 1 != inc.end()) {
+      line_starts.push_back(it + 1);
+    }
+  }
+
+  t.reset();
+  t.start();
+  std::size_t total_length{};
+  for (auto const& it : line_starts) {
+    total_length += inc.src_whereis(it).size();
+  }
+  t.stop();
+  std::printf("includer: %gs for %zu calls to src_whereis\n",
+              t.elapsed_real_time(),
+              line_starts.size());
+
+  // Sanity check: the last line is the last line of the last leaf.
+  std::string const expected =
+    leaf_name(n_mid - 1, n_leaf - 1) + ':' + std::to_string(n_lines);
+  if (total_length == 0 || inc.src_whereis(line_starts.back()) != expected) {
+    std::printf("Unexpected position of last line: %s\n",
+                inc.src_whereis(line_starts.back()).c_str());
+    return 1;
+  }
+
+  return 0;
+
+} // main()
@@ -4,7 +4,14 @@
 #include "cetlib/container_algorithms.h"
 #include "cetlib/map_vector.h"
 #include <boost/test/tools/output_test_stream.hpp>
+
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
 
 using cet::map_vector;
 using cet::map_vector_key;
@@ -191,4 +198,241 @@ BOOST_AUTO_TEST_CASE(nonemptymap_test)
   }
 }
 
+BOOST_AUTO_TEST_CASE(search_test)
+{
+  // Every key in and around each distribution is found exactly where
+  // std::lower_bound finds it.
+  auto check = [](std::vector<unsigned long> const& keys) {
+    map_vector<unsigned long> m;
+    for (auto const k : keys) {
+      m[map_vector_key{k}] = k;
+    }
+    std::vector<unsigned long> sorted_keys;
+    for (auto const& [key, value] : m) {
+      sorted_keys.push_back(key.asInt());
+    }
+    auto probe = [&m, &sorted_keys](unsigned long const k) {
+      map_vector_key const key{k};
+      auto const expected =
+        std::lower_bound(sorted_keys.cbegin(), sorted_keys.cend(), k);
+      bool const present = expected != sorted_keys.cend() && *expected == k;
+      BOOST_TEST(m.has(key) == present);
+      auto const it = m.find(key);
+      if (present) {
+        BOOST_TEST_REQUIRE((it != m.end()));
+        BOOST_TEST(it->second == k);
+      } else {
+        BOOST_TEST((it == m.end()));
+      }
+    };
+    for (auto const k : sorted_keys) {
+      probe(k);
+      probe(k + 1);
+      probe(k - 1);
+    }
+    probe(0);
+    probe(std::numeric_limits<unsigned long>::max() - 1);
+  };
+
+  std::mt19937_64 engine{4242};
+  std::vector<unsigned long> dense, sparse, clustered, extreme;
+  for (unsigned long i = 0; i != 5000; ++i) {
+    dense.push_back(100 + i);
+  }
+  dense.erase(dense.begin() + 2000); // One hole.
+  std::uniform_int_distribution<unsigned long> wide{0, 1ul << 40};
+  for (unsigned i = 0; i != 5000; ++i) {
+    sparse.push_back(wide(engine));
+  }
+  // Tight clusters far apart.
+  for (unsigned long c = 0; c != 20; ++c) {
+    for (unsigned long i = 0; i != 250; ++i) {
+      clustered.push_back(c * c * c * 1000000 + 3 * i);
+    }
+  }
+  for (unsigned long i = 0; i != 100; ++i) {
+    extreme.push_back(i);
+    extreme.push_back(std::numeric_limits<unsigned long>::max() - 2 - i);
+  }
+
+  check({});
+  check({7});
+  check(dense);
+  check(sparse);
+  check(clustered);
+  check(extreme);
+}
+
+BOOST_AUTO_TEST_CASE(bulk_insert_test)
+{
+  using entries_t = std::vector<std::pair<map_vector_key, unsigned>>;
+  std::mt19937 engine{2112};
+
+  // Unsorted entries with many repeated keys; the values record the
+  // order of the entries.
+  auto make_entries = [&engine](std::size_t const n, unsigned const offset) {
+    std::uniform_int_distribution<unsigned long> key{0, 2 * n};
+    entries_t result;
+    for (unsigned i = 0; i != n; ++i) {
+      result.emplace_back(map_vector_key{key(engine)}, offset + i);
+    }
+    return result;
+  };
+
+  for (auto const keep : {cet::map_vector_duplicates::keep_first,
+                          cet::map_vector_duplicates::keep_last}) {
+    auto const existing = make_entries(1000, 0);
+    auto const incoming = make_entries(5000, 1000);
+
+    // The expected result: existing entries, then incoming ones in
+    // order, with the first or the last entry of each key kept.
+    std::map<unsigned long, unsigned> expected;
+    for (auto const* entries : {&existing, &incoming}) {
+      for (auto const& [key, value] : *entries) {
+        if (keep == cet::map_vector_duplicates::keep_first) {
+          expected.emplace(key.asInt(), value);
+        } else {
+          expected.insert_or_assign(key.asInt(), value);
+        }
+      }
+    }
+
+    // Start with an unsorted bulk insertion too.
+    map_vector<unsigned> m;
+    m.bulk_insert(existing.begin(), existing.end(), keep);
+    m.bulk_insert(incoming.begin(), incoming.end(), keep);
+    BOOST_TEST_REQUIRE(m.size() == expected.size());
+    BOOST_TEST(std::equal(
+      m.begin(), m.end(), expected.begin(), [](auto const& a, auto const& b) {
+        return a.first.asInt() == b.first && a.second == b.second;
+      }));
+
+    // The number of threads does not affect the result.
+    map_vector<unsigned> m4;
+    m4.bulk_insert(existing.begin(), existing.end(), keep, 4);
+    m4.bulk_insert(incoming.begin(), incoming.end(), keep, 4);
+    BOOST_TEST(std::equal(m.begin(), m.end(), m4.begin(), m4.end()));
+
+    entries_t const none;
+    auto const copy = m;
+    m.bulk_insert(none.begin(), none.end(), keep);
+    BOOST_TEST(m.size() == copy.size());
+  }
+
+  {
+    // With keep_first, bulk_insert of sorted entries is the same as
+    // insert.
+    auto incoming = make_entries(3000, 0);
+    std::stable_sort(
+      incoming.begin(), incoming.end(), [](auto const& a, auto const& b) {
+        return a.first < b.first;
+      });
+    map_vector<unsigned> m1, m2;
+    m1[map_vector_key{17}] = 99;
+    m2[map_vector_key{17}] = 99;
+    m1.insert(incoming.begin(), incoming.end());
+    m2.bulk_insert(incoming.begin(), incoming.end());
+    BOOST_TEST(std::equal(m1.begin(), m1.end(), m2.begin(), m2.end()));
+  }
+
+  {
+    entries_t const invalid{{map_vector_key{}, 0}};
+    map_vector<unsigned> m;
+    BOOST_CHECK_THROW(m.bulk_insert(invalid.begin(), invalid.end()),
+                      cet::exception);
+    BOOST_TEST(m.empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(concatenate_test)
+{
+  // The concatenation of the inputs by repeated appends.
+  auto expected_concatenation = [](auto const& inputs) {
+    std::remove_const_t<std::remove_pointer_t<
+      typename std::decay_t<decltype(inputs)>::value_type>>
+      result;
+    for (auto const* input : inputs) {
+      auto const offset = result.delta();
+      for (auto const& [key, value] : *input) {
+        result[map_vector_key{key.asInt() + offset}] = value;
+      }
+    }
+    return result;
+  };
+
+  std::mt19937 engine{9};
+  std::uniform_int_distribution<unsigned> gap{1, 5};
+  auto make_input = [&engine, &gap](std::size_t const n) {
+    map_vector<unsigned> result;
+    unsigned long key{gap(engine)};
+    for (unsigned i = 0; i != n; ++i, key += gap(engine)) {
+      result[map_vector_key{key}] = i;
+    }
+    return result;
+  };
+
+  // Small and large inputs, including empty ones; the large ones are
+  // split between threads.
+  for (std::size_t const size : {10u, 100'000u}) {
+    std::vector<map_vector<unsigned>> const storage{
+      make_input(size), {}, make_input(size), make_input(size / 2), {}};
+    std::vector<map_vector<unsigned> const*> inputs;
+    for (auto const& input : storage) {
+      inputs.push_back(&input);
+    }
+    auto const expected = expected_concatenation(inputs);
+    for (unsigned const nthreads : {1u, 0u, 3u}) {
+      auto const [combined, offsets] = cet::concatenate(inputs, nthreads);
+      BOOST_TEST(std::equal(
+        combined.begin(), combined.end(), expected.begin(), expected.end()));
+      BOOST_TEST_REQUIRE(offsets.size() == inputs.size());
+      std::size_t offset{};
+      for (std::size_t i = 0; i != inputs.size(); ++i) {
+        BOOST_TEST(offsets[i] == offset);
+        offset += inputs[i]->delta();
+      }
+    }
+  }
+
+  {
+    // Moving the mapped values out of the inputs.
+    map_vector<std::string> a, b;
+    a[map_vector_key{3}] = "a3";
+    b[map_vector_key{0}] = "b0";
+    b[map_vector_key{2}] = "b2";
+    std::vector<map_vector<std::string>> inputs{a, b};
+    auto const [combined, offsets] = cet::concatenate(std::move(inputs));
+    BOOST_TEST(combined.size() == 3u);
+    BOOST_TEST(combined.getOrThrow(map_vector_key{3}) == "a3");
+    BOOST_TEST(combined.getOrThrow(map_vector_key{4}) == "b0");
+    BOOST_TEST(combined.getOrThrow(map_vector_key{6}) == "b2");
+    BOOST_TEST((offsets == std::vector<std::size_t>{0, 4}));
+  }
+
+  {
+    map_vector<int> const* none{nullptr};
+    auto const [combined, offsets] = cet::concatenate(&none, 0);
+    BOOST_TEST(combined.empty());
+    BOOST_TEST(offsets.empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_sort_test)
+{
+  // Enough entries for several threads, with repeated keys.
+  std::mt19937_64 engine{7};
+  std::uniform_int_distribution<unsigned long> key{0, 1u << 18};
+  std::vector<cet::detail::map_vector_sort_entry> entries;
+  for (std::size_t i = 0; i != 1u << 20; ++i) {
+    entries.emplace_back(key(engine), i);
+  }
+  auto expected = entries;
+  std::sort(expected.begin(), expected.end());
+  for (unsigned const nthreads : {1u, 2u, 3u, 8u}) {
+    auto sorted = entries;
+    cet::detail::sort_map_vector_entries(sorted, nthreads);
+    BOOST_TEST((sorted == expected));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
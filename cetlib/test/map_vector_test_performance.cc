@@ -0,0 +1,160 @@
+// ======================================================================
+//
+// map_vector_test_performance: time key lookups in map_vector and
+//                              soa_map_vector against std::lower_bound
+//                              over the same entries, for dense, sparse
+//                              and clustered key distributions.
+//
+// ======================================================================
+
+#include "cetlib/cpu_timer.h"
+#include "cetlib/map_vector.h"
+#include "cetlib/soa_map_vector.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+  std::size_t constexpr n_entries{1 << 20};
+  std::size_t constexpr n_lookups{1 << 19};
+
+  // Stands in for a simulated particle.
+  struct particle {
+    unsigned long id;
+    double data[15];
+  };
+
+  using key_t = cet::map_vector_key;
+  using entries_t = std::vector<std::pair<key_t, particle>>;
+
+  entries_t
+  make_entries(std::vector<unsigned long> keys)
+  {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    entries_t result;
+    result.reserve(keys.size());
+    for (auto const k : keys) {
+      result.emplace_back(key_t{k}, particle{k, {}});
+    }
+    return result;
+  }
+
+  // Lookups for keys spread over the range of the entries, about half of
+  // which are present.
+  std::vector<key_t>
+  make_lookups(entries_t const& entries, std::mt19937_64& engine)
+  {
+    std::uniform_int_distribution<std::size_t> index{0, entries.size() - 1};
+    std::vector<key_t> result;
+    result.reserve(n_lookups);
+    for (std::size_t i = 0; i != n_lookups; ++i) {
+      auto const k = entries[index(engine)].first.asInt();
+      result.emplace_back(i % 2 ? k : k + 1);
+    }
+    return result;
+  }
+
+  template <typename Lookup>
+  double
+  time_lookups(std::vector<key_t> const& lookups,
+               Lookup lookup,
+               unsigned long& checksum)
+  {
+    cet::cpu_timer t;
+    t.start();
+    for (auto const key : lookups) {
+      if (auto const* p = lookup(key)) {
+        checksum += p->id;
+      }
+    }
+    t.stop();
+    return t.elapsed_real_time() / lookups.size() * 1e9;
+  }
+
+  bool
+  run(char const* const name, std::vector<unsigned long> keys)
+  {
+    std::mt19937_64 engine{1234};
+    auto const entries = make_entries(std::move(keys));
+    auto const lookups = make_lookups(entries, engine);
+
+    cet::map_vector<particle> mv;
+    mv.append(entries.cbegin(), entries.cend());
+    cet::soa_map_vector<particle> smv;
+    smv.append(entries.cbegin(), entries.cend());
+
+    unsigned long sum_std{}, sum_mv{}, sum_smv{};
+    auto const t_std = time_lookups(
+      lookups,
+      [&entries](key_t const key) -> particle const* {
+        auto const it = std::lower_bound(
+          entries.cbegin(), entries.cend(), key, [](auto const& e, key_t k) {
+            return e.first < k;
+          });
+        return it != entries.cend() && it->first == key ? &it->second :
+                                                          nullptr;
+      },
+      sum_std);
+    auto const t_mv = time_lookups(
+      lookups, [&mv](key_t const key) { return mv.getOrNull(key); }, sum_mv);
+    auto const t_smv = time_lookups(
+      lookups, [&smv](key_t const key) { return smv.getOrNull(key); }, sum_smv);
+
+    std::printf("%-10s std::lower_bound %6.1f ns, map_vector %6.1f ns, "
+                "soa_map_vector %6.1f ns per lookup\n",
+                name,
+                t_std,
+                t_mv,
+                t_smv);
+    if (sum_mv != sum_std || sum_smv != sum_std) {
+      std::printf("%s: lookups disagree with std::lower_bound\n", name);
+      return false;
+    }
+    return true;
+  }
+}
+
+int
+main()
+{
+  std::mt19937_64 engine{42};
+  std::vector<unsigned long> dense, sparse, clustered;
+
+  // Consecutive keys, with 1% of them missing.
+  std::uniform_int_distribution<unsigned> percent{0, 99};
+  for (unsigned long k = 1; dense.size() != n_entries; ++k) {
+    if (percent(engine) != 0) {
+      dense.push_back(k);
+    }
+  }
+
+  // Uniformly random keys over a range 1000 times the entry count.
+  std::uniform_int_distribution<unsigned long> wide{0, 1000 * n_entries};
+  for (std::size_t i = 0; i != n_entries; ++i) {
+    sparse.push_back(wide(engine));
+  }
+
+  // Dense blocks of varying length at random offsets, as when several
+  // inputs' keys are combined.
+  std::uniform_int_distribution<unsigned long> block_length{1, 5000};
+  std::uniform_int_distribution<unsigned long> gap{1, 1ul << 30};
+  for (unsigned long start = 0; clustered.size() < n_entries;) {
+    auto const length = block_length(engine);
+    for (unsigned long i = 0; i != length; ++i) {
+      clustered.push_back(start + i);
+    }
+    start += length + gap(engine);
+  }
+  clustered.resize(n_entries);
+
+  bool const ok = run("dense", std::move(dense)) &&
+                  run("sparse", std::move(sparse)) &&
+                  run("clustered", std::move(clustered));
+  return ok ? 0 : 1;
+
+} // main()
@@ -0,0 +1,203 @@
+#define BOOST_TEST_MODULE (profiler test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/profiler.h"
+#include "cetlib/sqlite/ConnectionFactory.h"
+#include "cetlib/sqlite/select.h"
+#include "cetlib/write_profile.h"
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  double
+  work(unsigned const n)
+  {
+    double x{1.};
+    for (unsigned i = 0; i != n; ++i) {
+      x = std::sin(x) + 1.;
+    }
+    return x;
+  }
+
+  double
+  inner()
+  {
+    CET_PROFILE_SCOPE("inner");
+    return work(1000);
+  }
+
+  double
+  outer()
+  {
+    CET_PROFILE_SCOPE("outer");
+    double result{};
+    for (int i = 0; i != 3; ++i) {
+      result += inner();
+    }
+    return result;
+  }
+
+  std::size_t
+  count(std::string const& s, std::string const& what)
+  {
+    std::size_t result{};
+    for (auto pos = s.find(what); pos != std::string::npos;
+         pos = s.find(what, pos + 1)) {
+      ++result;
+    }
+    return result;
+  }
+
+  std::size_t
+  count_nodes(cet::profile_node const& node)
+  {
+    std::size_t result{node.children.size()};
+    for (auto const& child : node.children) {
+      result += count_nodes(child);
+    }
+    return result;
+  }
+
+  struct profiler_fixture {
+    profiler_fixture() { cet::profiler::clear(); }
+    ~profiler_fixture() { cet::profiler::disable(); }
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(profiler_test, profiler_fixture)
+
+BOOST_AUTO_TEST_CASE(disabled)
+{
+  BOOST_TEST(!cet::profiler::is_enabled());
+  outer();
+  BOOST_TEST(cet::profiler::call_tree().children.empty());
+}
+
+BOOST_AUTO_TEST_CASE(nested)
+{
+  cet::profiler::enable();
+  BOOST_TEST(cet::profiler::is_enabled());
+  outer();
+  outer();
+  inner();
+  cet::profiler::disable();
+  outer(); // Not recorded.
+
+  auto const root = cet::profiler::call_tree();
+  BOOST_TEST_REQUIRE(root.children.size() == 2u);
+  auto const& o = root.children[0];
+  BOOST_TEST(o.name == "outer");
+  BOOST_TEST(o.real_time.size() == 2u);
+  BOOST_TEST(o.cpu_time.size() == 2u);
+  BOOST_TEST_REQUIRE(o.children.size() == 1u);
+  auto const& i = o.children[0];
+  BOOST_TEST(i.name == "inner");
+  BOOST_TEST(i.real_time.size() == 6u);
+  BOOST_TEST(i.children.empty());
+  BOOST_TEST(i.real_time.sum() <= o.real_time.sum());
+  BOOST_TEST(i.real_time.sum() > 0.);
+  BOOST_TEST(root.children[1].name == "inner");
+  BOOST_TEST(root.children[1].real_time.size() == 1u);
+
+  std::ostringstream os;
+  cet::print(os, root);
+  auto const text = os.str();
+  BOOST_TEST(count(text, "\n") == 4u); // Heading and three nodes.
+  BOOST_TEST(count(text, "  outer\n") == 1u);
+  BOOST_TEST(count(text, "    inner\n") == 1u);
+
+  cet::profiler::clear();
+  BOOST_TEST(cet::profiler::call_tree().children.empty());
+}
+
+BOOST_AUTO_TEST_CASE(threads)
+{
+  unsigned constexpr nthreads{4};
+  unsigned constexpr ntasks{3000}; // Enough to fill several blocks.
+  cet::profiler::enable();
+  std::vector<double> results(nthreads);
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t != nthreads; ++t) {
+    threads.emplace_back([&x = results[t]] {
+      for (unsigned i = 0; i != ntasks; ++i) {
+        CET_PROFILE_SCOPE("task");
+        x += work(10);
+        CET_PROFILE_SCOPE("step");
+        x += work(10);
+      }
+    });
+  }
+  // Reading while the threads record sees only complete scopes.
+  for (auto const& node : cet::profiler::call_tree().children) {
+    BOOST_TEST(node.name == "task");
+    BOOST_TEST(node.real_time.size() <= nthreads * ntasks);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto const x : results) {
+    BOOST_TEST(x > 0.);
+  }
+
+  auto const root = cet::profiler::call_tree();
+  BOOST_TEST_REQUIRE(root.children.size() == 1u);
+  BOOST_TEST(root.children[0].real_time.size() == nthreads * ntasks);
+  BOOST_TEST_REQUIRE(root.children[0].children.size() == 1u);
+  BOOST_TEST(root.children[0].children[0].name == "step");
+  BOOST_TEST(root.children[0].children[0].cpu_time.size() ==
+             nthreads * ntasks);
+
+  // The buffers of the exited threads are freed.
+  cet::profiler::clear();
+  BOOST_TEST(cet::profiler::call_tree().children.empty());
+  std::thread{[] { CET_PROFILE_SCOPE("task"); }}.join();
+  BOOST_TEST(cet::profiler::call_tree().children.size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(chrome_trace)
+{
+  cet::profiler::enable();
+  outer();
+  {
+    CET_PROFILE_SCOPE("with \"quotes\"\n");
+  }
+  cet::profiler::disable();
+
+  std::ostringstream os;
+  cet::profiler::write_chrome_trace(os);
+  auto const json = os.str();
+  BOOST_TEST(json.rfind("{\"traceEvents\":[", 0) == 0u);
+  BOOST_TEST(count(json, "\"ph\":\"X\"") == 5u);
+  BOOST_TEST(count(json, "\"name\":\"inner\"") == 3u);
+  BOOST_TEST(count(json, "\"name\":\"with \\\"quotes\\\"\\u000a\"") == 1u);
+  BOOST_TEST(count(json, "\"ts\":0.000,") == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(sqlite)
+{
+  cet::profiler::enable();
+  outer();
+  inner();
+  cet::profiler::disable();
+  auto const root = cet::profiler::call_tree();
+
+  cet::sqlite::ConnectionFactory cf;
+  std::unique_ptr<cet::sqlite::Connection> c{cf.make_connection(":memory:")};
+  cet::write_profile(root, *c);
+
+  cet::sqlite::query_result<int> nrows;
+  nrows << cet::sqlite::select("count(*)").from(*c, "Profile");
+  BOOST_TEST(unique_value(nrows) == static_cast<int>(count_nodes(root)));
+
+  cet::sqlite::query_result<int> calls;
+  calls << cet::sqlite::select("Calls").from(*c, "Profile").where(
+    "Path='outer/inner'");
+  BOOST_TEST(unique_value(calls) == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -41,9 +41,64 @@
 
 using cet::sha1;
 
+#include "cetlib/MD5Digest.h"
+#include "cetlib/evp_digest.h"
+
 #include <stdio.h>
+#include <string>
 #include <sys/time.h>
 
+namespace {
+  double
+  now()
+  {
+    timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+  }
+
+  std::size_t const message_sizes[] = {64, 1024, 16384, 1u << 20};
+  std::size_t constexpr bytes_per_measurement{1u << 26};
+
+  // Print the throughput (MB/s) of hash_once, which hashes one message
+  // and returns a byte of its digest, for each message size.
+  template <typename F>
+  void
+  throughput(char const* name, F hash_once)
+  {
+    printf("%-18s", name);
+    for (auto const size : message_sizes) {
+      std::string const mesg(size, 'x');
+      auto const n = bytes_per_measurement / size;
+      unsigned sink{};
+      auto const start = now();
+      for (std::size_t i = 0; i != n; ++i) {
+        sink += hash_once(mesg);
+      }
+      auto const elapsed = now() - start;
+      printf(" %10.1f", n * size / elapsed / 1000000.0);
+      if (sink == 1) { // Keep the results alive.
+        printf("%c", ' ');
+      }
+    }
+    printf("\n");
+  }
+
+  template <typename Digest>
+  void
+  evp_throughput(char const* name)
+  {
+    if (!cet::digest_available(Digest::algorithm)) {
+      printf("%-18s unavailable\n", name);
+      return;
+    }
+    Digest h;
+    throughput(name, [&h](std::string const& mesg) {
+      return h.update(mesg.data(), mesg.size()).digest()[0];
+    });
+  }
+}
+
 int
 main()
 {
@@ -96,6 +151,25 @@ main()
     // =====================================
   }
 
+  // Throughput of the available digests for several message sizes.
+  printf("\nThroughput (MB/s) for message sizes (bytes):\n%-18s", "");
+  for (auto const size : message_sizes) {
+    printf(" %10zu", size);
+  }
+  printf("\n");
+
+  throughput("cet::sha1", [h = sha1{}](std::string const& mesg) mutable {
+    h.reset();
+    return h.update(mesg.data(), mesg.size()).digest()[0];
+  });
+  throughput("cet::MD5Digest", [](std::string const& mesg) {
+    return cet::MD5Digest{mesg.data(), mesg.size()}.digest().bytes[0];
+  });
+  evp_throughput<cet::sha1_digest>("cet::sha1_digest");
+  evp_throughput<cet::sha256_digest>("cet::sha256_digest");
+  evp_throughput<cet::blake2b512_digest>("blake2b512_digest");
+  evp_throughput<cet::blake2s256_digest>("blake2s256_digest");
+
   return 0;
 
 } // main()
@@ -4,6 +4,7 @@
 #include "cetlib/simple_stats.h"
 
 #include <cmath>
+#include <vector>
 
 using cet::simple_stats;
 
@@ -58,4 +59,48 @@ BOOST_AUTO_TEST_CASE(sample_test)
   BOOST_TEST(s.mean() == 0.0);
 }
 
+BOOST_AUTO_TEST_CASE(large_mean_test)
+{
+  // Timing-like data: a spread of 1 about a mean of 1e9.  Accumulating
+  // the raw sum of squares loses the spread entirely.
+  simple_stats s;
+  for (int i = 0; i != 1000; ++i) {
+    s.sample(1e9 + (i % 2 == 0 ? -1.0 : 1.0));
+  }
+
+  BOOST_TEST(s.mean() == 1e9);
+  BOOST_TEST(s.rms(0u) == 1.0, boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(s.rms() == std::sqrt(1000.0 / 999.0),
+             boost::test_tools::tolerance(1e-12));
+}
+
+BOOST_AUTO_TEST_CASE(merge_test)
+{
+  std::vector<double> data;
+  for (int i = 0; i != 100; ++i) {
+    data.push_back(1e6 + 0.5 * i - 0.01 * i * i);
+  }
+
+  simple_stats all;
+  all.sample(data.cbegin(), data.cend());
+
+  simple_stats a, b, c, empty;
+  a.sample(data.cbegin(), data.cbegin() + 10);
+  b.sample(data.cbegin() + 10, data.cbegin() + 73);
+  c.sample(data.cbegin() + 73, data.cend());
+  a.merge(empty);
+  empty.merge(b);
+  a.merge(empty);
+  a.merge(c);
+
+  BOOST_TEST(a.size() == all.size());
+  BOOST_TEST(a.min() == all.min());
+  BOOST_TEST(a.max() == all.max());
+  BOOST_TEST(a.small() == all.small());
+  BOOST_TEST(a.sum() == all.sum(), boost::test_tools::tolerance(1e-15));
+  BOOST_TEST(a.sumsq() == all.sumsq(), boost::test_tools::tolerance(1e-15));
+  BOOST_TEST(a.mean() == all.mean(), boost::test_tools::tolerance(1e-15));
+  BOOST_TEST(a.rms() == all.rms(), boost::test_tools::tolerance(1e-12));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
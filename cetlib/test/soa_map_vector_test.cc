@@ -0,0 +1,272 @@
+#define BOOST_TEST_MODULE (soa_map_vector test)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/container_algorithms.h"
+#include "cetlib/map_vector.h"
+#include "cetlib/soa_map_vector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using cet::map_vector;
+using cet::map_vector_key;
+using cet::soa_map_vector;
+
+BOOST_TEST_DONT_PRINT_LOG_VALUE(soa_map_vector<int>::const_iterator)
+BOOST_TEST_DONT_PRINT_LOG_VALUE(soa_map_vector<int>::iterator)
+
+namespace {
+  // Entries of a map_vector and a soa_map_vector are equal.
+  template <class Value>
+  bool
+  same_entries(map_vector<Value> const& mv, soa_map_vector<Value> const& smv)
+  {
+    return std::equal(
+      mv.begin(), mv.end(), smv.begin(), smv.end(), [](auto const& a, auto b) {
+        return a.first == b.first && a.second == b.second;
+      });
+  }
+
+  // A value whose copies throw while copies_throw is set, and which is
+  // left as -1 when moved from.
+  struct fragile {
+    explicit fragile(int const v = 0) : value{v} {}
+    fragile(fragile const& other) : value{other.value}
+    {
+      if (copies_throw)
+        throw std::runtime_error{"copy"};
+    }
+    fragile(fragile&& other) noexcept : value{std::exchange(other.value, -1)}
+    {}
+    fragile& operator=(fragile const&) = default;
+    fragile&
+    operator=(fragile&& other) noexcept
+    {
+      value = std::exchange(other.value, -1);
+      return *this;
+    }
+
+    int value;
+    static inline bool copies_throw{false};
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(soa_map_vector_test)
+
+BOOST_AUTO_TEST_CASE(emptymap_test)
+{
+  map_vector_key k(3);
+  {
+    soa_map_vector<int> m;
+    BOOST_TEST(m.empty());
+    BOOST_TEST(m.size() == 0u);
+    BOOST_TEST(!m.has(k));
+    BOOST_TEST(m.begin() == m.end());
+    BOOST_TEST((m.rbegin() == m.rend()));
+    BOOST_TEST(m.find(k) == m.end());
+    BOOST_TEST(m.getOrNull(k) == nullptr);
+    BOOST_CHECK_THROW(m.getOrThrow(k), cet::exception);
+    BOOST_CHECK_THROW(m.front(), cet::exception);
+    BOOST_CHECK_THROW(m.back(), cet::exception);
+    BOOST_TEST(m.delta() == 0u);
+  }
+
+  {
+    soa_map_vector<int> const m;
+    BOOST_TEST(m.empty());
+    BOOST_TEST(m.begin() == m.end());
+    BOOST_TEST(m.find(k) == m.end());
+    BOOST_TEST(m.getOrNull(k) == nullptr);
+    BOOST_CHECK_THROW(m.getOrThrow(k), cet::exception);
+    BOOST_CHECK_THROW(m.findOrThrow(k), cet::exception);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nonemptymap_test)
+{
+  using value_t = int;
+  soa_map_vector<value_t> m;
+  std::size_t sz(0);
+
+  for (unsigned const key : {1u, 3u, 5u, 2u}) {
+    map_vector_key const k(key);
+    value_t const v(10 + k.asInt());
+    m[k] = v;
+    BOOST_TEST(!m.empty());
+    BOOST_TEST(m.size() == ++sz);
+    BOOST_TEST(m.has(k));
+    BOOST_TEST(m.find(k)->first == k);
+    BOOST_TEST(m.find(k)->second == v);
+    BOOST_TEST(*m.getOrNull(k) == v);
+    BOOST_TEST(m.getOrThrow(k) == v);
+    BOOST_TEST(m.at(k) == v);
+  }
+
+  BOOST_TEST(std::is_sorted(m.keys().begin(), m.keys().end()));
+  BOOST_TEST(m.values() == (std::vector<value_t>{11, 12, 13, 15}));
+  BOOST_TEST(m.front().first == map_vector_key{1});
+  BOOST_TEST(m.back().second == 15);
+  BOOST_TEST(m.delta() == 6u);
+  BOOST_TEST(!m.has(map_vector_key{4}));
+  BOOST_TEST(m.find(map_vector_key{4}) == m.end());
+
+  {
+    auto m2 = m;
+    auto result = m2.insert({map_vector_key{4}, value_t{14}});
+    BOOST_TEST(result.second);
+    BOOST_TEST(result.first->second == 14);
+    BOOST_TEST(m2.size() == sz + 1);
+  }
+
+  {
+    // Insertion should fail for already-existing keys, and the
+    // iterator to the existing element should be returned.
+    auto m2 = m;
+    auto result = m2.insert({map_vector_key{2}, value_t{13}});
+    BOOST_TEST(!result.second);
+    BOOST_TEST(result.first->second == 12);
+  }
+
+  {
+    // Modification through iterators and pair-like references.
+    auto m2 = m;
+    cet::for_all(m2, [](auto&& pr) { pr.second += 2; });
+    for (auto const& [key, value] : m2) {
+      BOOST_TEST(value == m.getOrThrow(key) + 2);
+    }
+    m2.find(map_vector_key{3})->second = 0;
+    BOOST_TEST(m2[map_vector_key{3}] == 0);
+
+    // Existing entries are kept when inserting a range.
+    auto m3 = m;
+    m3.insert(m2.begin(), m2.end());
+    BOOST_TEST(m3.values() == m.values());
+  }
+
+  {
+    // A range insertion that throws leaves the map unchanged.
+    soa_map_vector<fragile> f;
+    f[map_vector_key{1}] = fragile{1};
+    f[map_vector_key{3}] = fragile{3};
+    std::vector<std::pair<map_vector_key, fragile>> incoming{
+      {map_vector_key{2}, fragile{2}}};
+    fragile::copies_throw = true;
+    BOOST_CHECK_THROW(f.insert(incoming.begin(), incoming.end()),
+                      std::runtime_error);
+    fragile::copies_throw = false;
+    BOOST_TEST_REQUIRE(f.size() == 2u);
+    BOOST_TEST(f.values()[0].value == 1);
+    BOOST_TEST(f.values()[1].value == 3);
+    f.insert(incoming.begin(), incoming.end());
+    BOOST_TEST(f.size() == 3u);
+    BOOST_TEST(f.values()[1].value == 2);
+  }
+
+  {
+    // Iterator arithmetic and reverse iteration.
+    auto const& cm = m;
+    BOOST_TEST(cm.end() - cm.begin() == 4);
+    BOOST_TEST(cm.begin()[2].second == 13);
+    BOOST_TEST((cm.begin() + 3)->second == 15);
+    BOOST_TEST(std::prev(cm.end())->first == map_vector_key{5});
+    soa_map_vector<value_t>::const_iterator const it = m.begin();
+    BOOST_TEST(it == cm.cbegin());
+    std::vector<value_t> reversed;
+    for (auto r = cm.rbegin(); r != cm.rend(); ++r) {
+      reversed.push_back(r->second);
+    }
+    BOOST_TEST(reversed == (std::vector<value_t>{15, 13, 12, 11}));
+    BOOST_TEST(std::find_if(cm.begin(), cm.end(), [](auto pr) {
+                 return pr.second == 13;
+               }) == cm.find(map_vector_key{3}));
+  }
+
+  {
+    // Test appending elements
+    decltype(m) new_m;
+    auto const offset = m.delta();
+    auto const old_size = m.size();
+    new_m[map_vector_key{offset}] = value_t{43};
+    new_m[map_vector_key{offset + 1}] = value_t{17};
+    m.append(new_m.cbegin(), new_m.cend());
+    BOOST_TEST(m.size() == old_size + new_m.size());
+    BOOST_TEST(m.back().second == 17);
+  }
+
+  {
+    soa_map_vector<value_t> other;
+    other[map_vector_key{7}] = 1;
+    other.swap(m);
+    BOOST_TEST(m.size() == 1u);
+    BOOST_TEST(other.size() == 6u);
+    m.clear();
+    BOOST_TEST(m.empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(compare_with_map_vector)
+{
+  std::mt19937 engine{42};
+  std::uniform_int_distribution<unsigned> key_dist{0, 2000};
+
+  map_vector<std::string> mv;
+  soa_map_vector<std::string> smv;
+  for (unsigned i = 0; i != 1000; ++i) {
+    map_vector_key const key{key_dist(engine)};
+    auto const value = std::to_string(i);
+    if (i % 2) {
+      mv[key] = value;
+      smv[key] = value;
+    } else {
+      auto const r1 = mv.insert({key, value});
+      auto const r2 = smv.insert({key, value});
+      BOOST_TEST(r1.second == r2.second);
+    }
+  }
+  BOOST_TEST(same_entries(mv, smv));
+
+  for (unsigned k = 0; k != 2001; ++k) {
+    map_vector_key const key{k};
+    BOOST_TEST(mv.has(key) == smv.has(key));
+    auto const* p = smv.getOrNull(key);
+    BOOST_TEST((p == nullptr) == (mv.getOrNull(key) == nullptr));
+    if (p != nullptr) {
+      BOOST_TEST(*p == *mv.getOrNull(key));
+    }
+  }
+
+  // Merging sorted ranges, including duplicates, matches map_vector.
+  std::vector<std::pair<map_vector_key, std::string>> incoming;
+  for (unsigned i = 0; i != 500; ++i) {
+    incoming.emplace_back(map_vector_key{key_dist(engine) * 2},
+                          "new" + std::to_string(i));
+  }
+  std::sort(incoming.begin(), incoming.end(), [](auto const& a, auto const& b) {
+    return a.first < b.first;
+  });
+  mv.insert(incoming.begin(), incoming.end());
+  smv.insert(incoming.begin(), incoming.end());
+  BOOST_TEST(same_entries(mv, smv));
+
+  // Conversion from a map_vector.
+  soa_map_vector<std::string> const converted(mv.begin(), mv.end());
+  BOOST_TEST(same_entries(mv, converted));
+
+  // Unsorted bulk insertion, with either duplicate policy.
+  std::shuffle(incoming.begin(), incoming.end(), engine);
+  for (auto const keep : {cet::map_vector_duplicates::keep_first,
+                          cet::map_vector_duplicates::keep_last}) {
+    auto mv2 = mv;
+    auto smv2 = smv;
+    mv2.bulk_insert(incoming.begin(), incoming.end(), keep);
+    smv2.bulk_insert(incoming.begin(), incoming.end(), keep);
+    BOOST_TEST(same_entries(mv2, smv2));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,49 @@
+// ======================================================================
+//
+// timer_clocks: Cheap, high-resolution clocks for timing short intervals
+//
+// ======================================================================
+
+#include "cetlib/timer_clocks.h"
+
+#ifdef CET_TIMER_CLOCKS_TSC
+#include <cpuid.h>
+#endif
+
+namespace {
+  // Long enough for the error in the calibration to be below 1e-5.
+  cet::monotonic_clock::rep constexpr calibration_ns{10000000};
+}
+
+bool
+cet::tsc_clock::is_invariant() noexcept
+{
+#ifdef CET_TIMER_CLOCKS_TSC
+  unsigned eax{}, ebx{}, ecx{}, edx{};
+  if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007 ||
+      !__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+auto
+cet::tsc_clock::calibrate() noexcept -> calibration_t
+{
+#ifdef CET_TIMER_CLOCKS_TSC
+  if (is_invariant()) {
+    auto const t0 = monotonic_clock::now();
+    auto const c0 = __rdtsc();
+    auto t1 = t0;
+    do {
+      t1 = monotonic_clock::now();
+    } while (t1 - t0 < calibration_ns);
+    auto const c1 = __rdtsc();
+    return {true, monotonic_clock::seconds(t1 - t0) / (c1 - c0)};
+  }
+#endif
+  return {false, monotonic_clock::seconds(1)};
+}
@@ -0,0 +1,123 @@
+#ifndef cetlib_timer_clocks_h
+#define cetlib_timer_clocks_h
+
+// ======================================================================
+//
+// timer_clocks: Cheap, high-resolution clocks for timing short intervals
+//
+// Each clock has the same static interface:
+//
+//   rep now() noexcept;                  // A reading, in ticks.
+//   double seconds(rep ticks) noexcept;  // A tick count in seconds.
+//
+// monotonic_clock:   wallclock time, from clock_gettime(CLOCK_MONOTONIC),
+//                    in nanoseconds.  Unaffected by changes to the
+//                    system time.
+// thread_cpu_clock:  CPU time (user + system) consumed by the calling
+//                    thread, from CLOCK_THREAD_CPUTIME_ID, in
+//                    nanoseconds.  Readings from different threads
+//                    cannot be compared.
+// process_cpu_clock: CPU time consumed by all threads of the process,
+//                    from CLOCK_PROCESS_CPUTIME_ID, in nanoseconds.
+// tsc_clock:         wallclock time from the processor's time-stamp
+//                    counter, converted to seconds by a calibration
+//                    against monotonic_clock made on first use (which
+//                    takes 10 ms).  Reading it costs a few nanoseconds,
+//                    against a few tens for monotonic_clock.
+//                    It is only trustworthy where is_invariant() (the
+//                    counter runs at a constant rate, synchronized
+//                    across cores); elsewhere, and on processors without
+//                    a TSC, it reads monotonic_clock.
+//
+// monotonic_clock is normally read without a system call; the CPU-time
+// clocks need one, costing a few hundred nanoseconds, but that is still
+// cheaper than getrusage() and without its microsecond granularity.
+//
+// ======================================================================
+
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CET_TIMER_CLOCKS_TSC
+#include <x86intrin.h>
+#endif
+
+namespace cet {
+  namespace detail {
+    template <clockid_t Id>
+    struct posix_clock;
+  }
+
+  using monotonic_clock = detail::posix_clock<CLOCK_MONOTONIC>;
+  using thread_cpu_clock = detail::posix_clock<CLOCK_THREAD_CPUTIME_ID>;
+  using process_cpu_clock = detail::posix_clock<CLOCK_PROCESS_CPUTIME_ID>;
+  struct tsc_clock;
+}
+
+// ======================================================================
+
+template <clockid_t Id>
+struct cet::detail::posix_clock {
+  using rep = std::int64_t;
+
+  static rep
+  now() noexcept
+  {
+    timespec ts;
+    clock_gettime(Id, &ts);
+    return ts.tv_sec * rep{1000000000} + ts.tv_nsec;
+  }
+
+  static constexpr double
+  seconds(rep const ticks) noexcept
+  {
+    return ticks * 1e-9;
+  }
+};
+
+// ======================================================================
+
+struct cet::tsc_clock {
+  using rep = std::int64_t;
+
+  static bool is_invariant() noexcept;
+
+  static rep
+  now() noexcept
+  {
+#ifdef CET_TIMER_CLOCKS_TSC
+    if (calibration().use_tsc) {
+      return static_cast<rep>(__rdtsc());
+    }
+#endif
+    return monotonic_clock::now();
+  }
+
+  static double
+  seconds(rep const ticks) noexcept
+  {
+    return ticks * calibration().seconds_per_tick;
+  }
+
+private:
+  struct calibration_t {
+    bool use_tsc;
+    double seconds_per_tick;
+  };
+
+  static calibration_t calibrate() noexcept;
+
+  static calibration_t const&
+  calibration() noexcept
+  {
+    static calibration_t const c = calibrate();
+    return c;
+  }
+};
+
+#endif /* cetlib_timer_clocks_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,48 @@
+#ifndef cetlib_write_plugin_load_times_h
+#define cetlib_write_plugin_load_times_h
+////////////////////////////////////////////////////////////////////////
+// write_plugin_load_times
+//
+// Write the entries of a cet::PluginLoadTimes object into a table of
+// an SQLite database, via cet::sqlite::Ntuple.  The table has the
+// columns:
+//
+//   Stage (TEXT), Library (TEXT), Symbol (TEXT), RealTime (NUMERIC),
+//   CPUTime (NUMERIC)
+//
+// Using this header requires linking against cetlib::sqlite.
+////////////////////////////////////////////////////////////////////////
+
+#include "cetlib/PluginLoadTimes.h"
+#include "cetlib/sqlite/Connection.h"
+#include "cetlib/sqlite/Ntuple.h"
+
+#include <string>
+
+namespace cet {
+  inline void
+  write_plugin_load_times(PluginLoadTimes const& times,
+                          sqlite::Connection& connection,
+                          std::string const& table_name = "PluginLoadTimes",
+                          bool const overwrite_contents = false)
+  {
+    sqlite::Ntuple<std::string, std::string, std::string, double, double> nt{
+      connection,
+      table_name,
+      {{"Stage", "Library", "Symbol", "RealTime", "CPUTime"}},
+      overwrite_contents};
+    for (auto const& entry : times.entries()) {
+      nt.insert(to_string(entry.stage),
+                entry.library,
+                entry.symbol,
+                entry.real_time,
+                entry.cpu_time);
+    }
+  }
+}
+
+#endif /* cetlib_write_plugin_load_times_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,93 @@
+#ifndef cetlib_write_profile_h
+#define cetlib_write_profile_h
+////////////////////////////////////////////////////////////////////////
+// write_profile
+//
+// Write a call tree from cet::profiler into a table of an SQLite
+// database, via cet::sqlite::Ntuple, one row per node.  The table has
+// the columns:
+//
+//   Path (TEXT), Name (TEXT), Depth (INTEGER), Calls (INTEGER),
+//   RealTime (NUMERIC), RealMean (NUMERIC), RealRMS (NUMERIC),
+//   RealMax (NUMERIC), CPUTime (NUMERIC), CPUMean (NUMERIC)
+//
+// where Path is the names of the enclosing scopes and the node's own,
+// separated by '/'; times are in seconds, and those other than the
+// totals RealTime and CPUTime are per call.
+//
+// Using this header requires linking against cetlib::sqlite.
+////////////////////////////////////////////////////////////////////////
+
+#include "cetlib/profiler.h"
+#include "cetlib/sqlite/Connection.h"
+#include "cetlib/sqlite/Ntuple.h"
+
+#include <string>
+
+namespace cet {
+  namespace detail {
+    template <class Ntuple>
+    void
+    write_profile_node(Ntuple& nt,
+                       profile_node const& node,
+                       std::string const& parent_path,
+                       int const depth)
+    {
+      auto const path =
+        parent_path.empty() ? node.name : parent_path + '/' + node.name;
+      nt.insert(path,
+                node.name,
+                depth,
+                static_cast<int>(node.real_time.size()),
+                node.real_time.sum(),
+                node.real_time.mean(),
+                node.real_time.rms(),
+                node.real_time.max(),
+                node.cpu_time.sum(),
+                node.cpu_time.mean());
+      for (auto const& child : node.children) {
+        write_profile_node(nt, child, path, depth + 1);
+      }
+    }
+  }
+
+  inline void
+  write_profile(profile_node const& root,
+                sqlite::Connection& connection,
+                std::string const& table_name = "Profile",
+                bool const overwrite_contents = false)
+  {
+    sqlite::Ntuple<std::string,
+                   std::string,
+                   int,
+                   int,
+                   double,
+                   double,
+                   double,
+                   double,
+                   double,
+                   double>
+      nt{connection,
+         table_name,
+         {{"Path",
+           "Name",
+           "Depth",
+           "Calls",
+           "RealTime",
+           "RealMean",
+           "RealRMS",
+           "RealMax",
+           "CPUTime",
+           "CPUMean"}},
+         overwrite_contents};
+    for (auto const& child : root.children) {
+      detail::write_profile_node(nt, child, std::string{}, 0);
+    }
+  }
+}
+
+#endif /* cetlib_write_profile_h */
+
+// Local Variables:
+// mode: c++
+// End:
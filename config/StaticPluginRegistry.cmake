@@ -0,0 +1,129 @@
+#[================================================================[.rst:
+StaticPluginRegistry
+--------------------
+
+Defines the function :command:`cet_static_plugin_registry`, to link
+plugins statically into a target and generate a registry of their
+functions (see ``cetlib/static_plugin_registry.h``).
+``cet::PluginFactory`` and ``cet::BasicPluginFactory`` consult that
+registry before falling back to ``cet::LibraryManager``, so a program
+whose plugins are all statically registered performs no library search
+and no ``dlopen`` to create them.
+
+.. command:: cet_static_plugin_registry
+
+   .. code-block:: cmake
+
+      cet_static_plugin_registry(<target>
+                                 PLUGINS <libspec>:<plugin-target>...
+                                 [PLUGIN_TYPE <suffix>]
+                                 [SYMBOLS <symbol>...])
+
+   ``PLUGINS <libspec>:<plugin-target>...``
+     Each plugin's full libspec (e.g. ``a/b/MyPlugin``), and the
+     library target describing its implementation, usually the one
+     made by ``basic_plugin()`` for dynamic loading (or an alias of
+     it). The plugin target is neither linked nor modified: each of its C++
+     sources is compiled again for ``<target>``, by a generated source
+     file that defines ``CET_STATIC_PLUGIN_PREFIX`` and includes it,
+     with the plugin target's compile definitions and options and
+     linked to its libraries. The same plugin target may therefore be
+     used by several registries. Its sources must be plain file names
+     (not generator expressions), and must define their ``extern "C"``
+     functions using the ``MAKE_PLUGIN_START``,
+     ``DEFINE_BASIC_PLUGINTYPE_FUNC`` and ``CET_PROVIDE_FILE_PATH``
+     macros, or the ``CET_PLUGIN_SYMBOL`` macro
+     (``cetlib/PluginSymbolMacro.h``).
+
+   ``PLUGIN_TYPE <suffix>``
+     The library type of the plugins (default ``plugin``), as used by
+     the corresponding plugin factory.
+
+   ``SYMBOLS <symbol>...``
+     The functions provided by every plugin, and registered (default
+     ``makePlugin``). Plugins for ``cet::BasicPluginFactory`` define
+     ``pluginType`` too, and need ``SYMBOLS makePlugin pluginType``.
+
+#]================================================================]
+
+include_guard()
+
+set(_cet_static_plugin_registry_template
+  "${CMAKE_CURRENT_LIST_DIR}/static_plugin_registry.cc.in")
+
+function(cet_static_plugin_registry TARGET)
+  cmake_parse_arguments(PARSE_ARGV 1 SPR "" "PLUGIN_TYPE" "PLUGINS;SYMBOLS")
+  if (NOT SPR_PLUGINS)
+    message(FATAL_ERROR "cet_static_plugin_registry(${TARGET}): no PLUGINS specified")
+  endif()
+  if (NOT SPR_PLUGIN_TYPE)
+    set(SPR_PLUGIN_TYPE plugin)
+  endif()
+  if (NOT SPR_SYMBOLS)
+    set(SPR_SYMBOLS makePlugin)
+  endif()
+  set(DECLARATIONS)
+  set(ENTRIES)
+  foreach (plugin IN LISTS SPR_PLUGINS)
+    if (NOT plugin MATCHES "^([^:]+):(.+)$")
+      message(FATAL_ERROR "cet_static_plugin_registry(${TARGET}): "
+        "expected <libspec>:<plugin-target>, got ${plugin}")
+    endif()
+    set(libspec "${CMAKE_MATCH_1}")
+    set(plugin_target "${CMAKE_MATCH_2}")
+    get_property(aliased TARGET ${plugin_target} PROPERTY ALIASED_TARGET)
+    if (aliased)
+      set(plugin_target ${aliased})
+    endif()
+    # Compile the plugin's sources again, giving its extern "C"
+    # functions names unique to the program (see
+    # cetlib/PluginSymbolMacro.h).
+    string(MAKE_C_IDENTIFIER "cet_static_${SPR_PLUGIN_TYPE}_${libspec}" prefix)
+    get_target_property(plugin_sources ${plugin_target} SOURCES)
+    get_target_property(plugin_source_dir ${plugin_target} SOURCE_DIR)
+    set(sources)
+    foreach (source IN LISTS plugin_sources)
+      if (source MATCHES "^\\$<")
+        message(FATAL_ERROR "cet_static_plugin_registry(${TARGET}): "
+          "cannot use source ${source} of ${plugin_target}")
+      endif()
+      if (NOT source MATCHES "\\.(cc|cpp|cxx|C)$")
+        continue()
+      endif()
+      get_filename_component(source "${source}" ABSOLUTE
+        BASE_DIR "${plugin_source_dir}")
+      list(LENGTH sources n)
+      set(wrapper "${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_${prefix}_${n}.cc")
+      file(CONFIGURE OUTPUT "${wrapper}" @ONLY CONTENT
+        "// Generated by cet_static_plugin_registry(): do not edit.
+#define CET_STATIC_PLUGIN_PREFIX @prefix@
+#include \"@source@\"
+")
+      list(APPEND sources "${wrapper}")
+    endforeach()
+    set(plugin_objects ${TARGET}_${prefix})
+    add_library(${plugin_objects} OBJECT ${sources})
+    target_compile_definitions(${plugin_objects}
+      PRIVATE $<TARGET_PROPERTY:${plugin_target},COMPILE_DEFINITIONS>)
+    target_compile_options(${plugin_objects}
+      PRIVATE $<TARGET_PROPERTY:${plugin_target},COMPILE_OPTIONS>)
+    target_include_directories(${plugin_objects}
+      PRIVATE $<TARGET_PROPERTY:${plugin_target},INCLUDE_DIRECTORIES>)
+    target_link_libraries(${plugin_objects}
+      PUBLIC $<TARGET_PROPERTY:${plugin_target},LINK_LIBRARIES>)
+    target_link_libraries(${TARGET} PRIVATE ${plugin_objects})
+    foreach (symbol IN LISTS SPR_SYMBOLS)
+      string(APPEND DECLARATIONS "  void ${prefix}_${symbol}();\n")
+      string(APPEND ENTRIES "    {\"${SPR_PLUGIN_TYPE}\",\n"
+        "     \"${libspec}\",\n"
+        "     \"${symbol}\",\n"
+        "     reinterpret_cast<void*>(&${prefix}_${symbol})},\n")
+    endforeach()
+  endforeach()
+  set(registry_source
+    "${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_static_plugin_registry.cc")
+  configure_file(${_cet_static_plugin_registry_template}
+    ${registry_source} @ONLY)
+  target_sources(${TARGET} PRIVATE ${registry_source})
+  target_link_libraries(${TARGET} PRIVATE cetlib::cetlib)
+endfunction()